@@ -27,16 +27,31 @@
 #include "ProgramStuff.h"
 #include "Grid15/Grid.h"
 #include "Grid15/GridHelp.h"
+#include "Grid15/MoveJournal.h"
 
 #include "termcolor/termcolor.hpp"
 
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <cstdio>
 #include <string>
 #include <sstream>
 #include <array>
+#include <vector>
 #include <exception>
+#include <stdexcept>
+#include <memory>
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
+#if defined(__SLIDEWINDOWS)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
 
 
 /* Command Handling */
@@ -48,6 +63,9 @@ enum class CommandUI::command
     demo,
     newgame,
     slide,
+    moves,
+    undo,
+    redo,
     print,
     save,
     load,
@@ -67,6 +85,9 @@ const std::unordered_map<std::string, CommandUI::command> CommandUI::commandMap
     {"demo",    CommandUI::command::demo},
     {"newgame", CommandUI::command::newgame},
     {"slide",   CommandUI::command::slide},
+    {"moves",   CommandUI::command::moves},
+    {"undo",    CommandUI::command::undo},
+    {"redo",    CommandUI::command::redo},
     {"print",   CommandUI::command::print},
     {"save",    CommandUI::command::save},
     {"load",    CommandUI::command::load},
@@ -101,6 +122,346 @@ void CommandUI::start(Grid15::Grid &grid)
     }
 }
 
+/** \brief Checks if commands come from someone typing, or from a pipe or file
+ *
+ * \return If stdin is a terminal (true) or not (false)
+ */
+bool CommandUI::inputIsTerminal()
+{
+    #if defined(__SLIDEWINDOWS)
+    return _isatty(_fileno(stdin)) != 0;
+    #else
+    return isatty(STDIN_FILENO) != 0;
+    #endif
+}
+
+/** \brief Checks if 15Slide should be started in machine mode (see CommandUI::startMachine)
+ *
+ * \param argc The number of command line arguments
+ * \param argv The command line arguments
+ * \return If "--machine" or "-m" was given, or if stdin is not a terminal
+ */
+bool CommandUI::wantsMachineMode(int argc, char *argv[])
+{
+    for (int i {1}; i < argc; ++i)
+    {
+        const std::string argument {argv[i]};
+
+        if (argument == "--machine" || argument == "-m")
+            return true;
+    }
+
+    return !inputIsTerminal();
+}
+
+/** \brief The main loop for scripts: reads line-delimited commands from stdin and writes one response line per command
+ *
+ * There are no prompts, colours or box-drawn grids. Input is read in large blocks and responses are buffered, and both are
+ * only flushed once every complete line read so far has been answered, so a script piping whole files is not slowed by
+ * small writes, and one waiting for each response is never left waiting. See CommandUI::handleMachineCommand for the responses.
+ *
+ * \param grid A Grid to use
+ */
+void CommandUI::startMachine(Grid15::Grid &grid)
+{
+    std::vector<char> input (MACHINE_BUFFER_SIZE);
+    std::size_t used {0};//bytes of input that are not part of a handled line yet
+    std::string responses {};
+    responses.reserve(MACHINE_BUFFER_SIZE + 64);
+
+    const auto writeResponses
+    {
+        [&responses]()
+        {
+            std::fwrite(responses.data(), 1, responses.size(), stdout);
+            std::fflush(stdout);
+            responses.clear();
+        }
+    };
+
+    while (!wantsToExit)
+    {
+        if (used == input.size())//a line longer than the buffer
+            input.resize(input.size() * 2);
+
+        #if defined(__SLIDEWINDOWS)
+        const int bytesRead {_read(_fileno(stdin), input.data() + used, static_cast<unsigned int> (input.size() - used))};
+        #else
+        const ssize_t bytesRead {read(STDIN_FILENO, input.data() + used, input.size() - used)};//returns whatever is ready, unlike std::fread
+        #endif
+
+        if (bytesRead <= 0)//end of input (or an error)
+        {
+            if (used != 0)//the last line had no newline
+                handleMachineCommand(input.data(), input.data() + used, grid, responses);
+            break;
+        }
+
+        used += static_cast<std::size_t> (bytesRead);
+
+        const char *first {input.data()};
+        const char *last {input.data() + used};
+
+        while (!wantsToExit)
+        {
+            const char *lineEnd {static_cast<const char *> (std::memchr(first, '\n', static_cast<std::size_t> (last - first)))};
+
+            if (lineEnd == nullptr)
+                break;
+
+            handleMachineCommand(first, lineEnd, grid, responses);
+            first = {lineEnd + 1};
+
+            if (responses.size() >= MACHINE_BUFFER_SIZE)
+                writeResponses();
+        }
+
+        used = {static_cast<std::size_t> (last - first)};
+        std::memmove(input.data(), first, used);//keep the start of an unfinished line
+
+        writeResponses();
+    }
+
+    writeResponses();
+}
+
+/** \brief Handles one command in machine mode and adds its response line
+ *
+ * Commands are the same as for CommandUI::handleCommand (a tile number on its own slides it), but each gets exactly one line:
+ * "ok" followed by what the command gives back, or "err" followed by why it failed. Moves give back " won" if the game is
+ * won; "moves" gives back how many moves were made, "undo" and "redo" the tile slid, and "print" and "newgame" the grid as
+ * 16 numbers in reading order (see Grid15::GridHelp::formatGridArray). Blank lines get no response.
+ *
+ * \param first The start of the line
+ * \param last The end of the line (the newline, if there is one, is not part of it)
+ * \param grid The Grid to change
+ * \param responses Where to add the response
+ */
+void CommandUI::handleMachineCommand(const char *first, const char *last, Grid15::Grid &grid, std::string &responses)
+{
+    constexpr auto isSpace
+    {
+        [](const char character)
+        {
+            return character == ' ' || character == '\t' || character == '\r';
+        }
+    };
+
+    const auto addGrid
+    {
+        [&responses](const Grid15::Grid::gridArray_t &gridArray)
+        {
+            std::array<char, Grid15::GridHelp::FORMATTED_GRID_SIZE> formatted;
+
+            responses += ' ';
+            responses.append(formatted.data(), Grid15::GridHelp::formatGridArray(gridArray, formatted.data()));
+        }
+    };
+
+    const auto addWon
+    {
+        [&responses, &grid, this]()
+        {
+            if (Grid15::GridHelp::hasWon(grid))
+            {
+                responses += " won";
+                wantsToExit = {autoExit};
+            }
+        }
+    };
+
+    while ((first != last) && isSpace(*first))
+        ++first;
+    while ((last != first) && isSpace(*(last - 1)))
+        --last;
+
+    if (first == last)
+        return;
+
+    CommandUI::command parsedCommand {CommandUI::command::slide};//a tile on its own, the most common command
+    const char *arguments {first};
+
+    if (*first < '0' || *first > '9')
+    {
+        const char *nameEnd {std::find_if(first, last, isSpace)};
+        const auto foundCommand {CommandUI::commandMap.find(std::string {first, nameEnd})};
+
+        parsedCommand = {(foundCommand != CommandUI::commandMap.end()) ? foundCommand->second : CommandUI::command::invalid};
+
+        arguments = {nameEnd};
+        while ((arguments != last) && isSpace(*arguments))
+            ++arguments;
+    }
+
+    const std::string argument {arguments, last};
+
+    switch (parsedCommand)
+    {
+        case CommandUI::command::slide:
+        {
+            unsigned int tile {0};
+            const std::from_chars_result result {std::from_chars(arguments, last, tile)};
+
+            if ((result.ec != std::errc {}) || (result.ptr != last) || (tile > Grid15::Grid::TILE_MAX)
+                || !Grid15::GridHelp::validMoveUnchecked(static_cast<std::uint8_t> (tile), grid))
+            {
+                responses += "err not a valid tile";
+                break;
+            }
+
+            const std::uint8_t tileNum {static_cast<std::uint8_t> (tile)};
+            history.slideUnchecked(tileNum, grid);//checked just above
+            autoSaveMoves(&tileNum, 1, grid);
+
+            responses += "ok";
+            addWon();
+            break;
+        }
+        case CommandUI::command::moves:
+        {
+            if (argument == "")
+            {
+                responses += "err no moves given";
+                break;
+            }
+
+            try
+            {
+                const std::vector<std::uint8_t> tiles {Grid15::GridHelp::parseMoves(argument, grid)};
+
+                for (const std::uint8_t tileNum : tiles)
+                    history.slideUnchecked(tileNum, grid);//parseMoves checked every move
+                autoSaveMoves(tiles.data(), tiles.size(), grid);
+
+                std::array<char, 24> count;
+                responses += "ok ";
+                responses.append(count.data(), std::to_chars(count.data(), count.data() + count.size(), tiles.size()).ptr);
+                addWon();
+            }
+            catch (std::invalid_argument &e)
+            {
+                responses += "err ";
+                responses += e.what();
+            }
+            break;
+        }
+        case CommandUI::command::undo:
+        case CommandUI::command::redo:
+        {
+            const bool undoing {parsedCommand == CommandUI::command::undo};
+            const std::uint8_t tileNum {undoing ? history.undo(grid) : history.redo(grid)};
+
+            if (tileNum == Grid15::Grid::NO_TILE)
+                responses += undoing ? "err nothing to undo" : "err nothing to redo";
+            else
+            {
+                const std::uint8_t move {undoing ? Grid15::MoveJournal::UNDO : Grid15::MoveJournal::REDO};//journaled as an undo or redo, not a new move
+                autoSaveMoves(&move, 1, grid);
+
+                std::array<char, 4> tile;
+                responses += "ok ";
+                responses.append(tile.data(), std::to_chars(tile.data(), tile.data() + tile.size(), static_cast<unsigned int> (tileNum)).ptr);
+                addWon();
+            }
+            break;
+        }
+        case CommandUI::command::print:
+        {
+            if (argument == "" || argument == "grid")
+            {
+                responses += "ok";
+                addGrid(grid.gridArray);
+            }
+            else if (argument == "goal")
+            {
+                responses += "ok";
+                addGrid(Grid15::Grid::GOAL_GRID);
+            }
+            else
+                responses += "err not a valid grid";
+            break;
+        }
+        case CommandUI::command::newgame:
+        {
+            Grid15::GridHelp::safeCopy(Grid15::GridHelp::generateRandomGrid(), grid);
+
+            defaultSaveFile = {""};
+            journal.reset();
+            history.clear();
+
+            responses += "ok";
+            addGrid(grid.gridArray);
+            break;
+        }
+        case CommandUI::command::save:
+        case CommandUI::command::load:
+        {
+            if (argument == "")
+            {
+                responses += "err no file given";
+                break;
+            }
+
+            try
+            {
+                journal.reset();
+
+                if (parsedCommand == CommandUI::command::save)
+                {
+                    Grid15::GridHelp::save(argument, grid, history);
+                    Grid15::MoveJournal::discard(argument);//the journal belongs to the old save
+                }
+                else
+                    Grid15::MoveJournal::load(argument, grid, history);//also replays any moves journaled since the save
+
+                defaultSaveFile = {argument};
+                responses += "ok";
+            }
+            catch (std::ios_base::failure &e)
+            {
+                responses += (parsedCommand == CommandUI::command::save) ? "err could not save" : "err could not load";
+            }
+            catch (std::invalid_argument &e)
+            {
+                responses += "err the grid is corrupted";
+            }
+            break;
+        }
+        case CommandUI::command::enable:
+        case CommandUI::command::disable:
+        {
+            if (handleOptions(argument, parsedCommand == CommandUI::command::enable))
+                responses += "ok";
+            else
+                responses += "err not a valid option";
+            break;
+        }
+        case CommandUI::command::exit:
+        {
+            wantsToExit = true;
+            responses += "ok";
+            break;
+        }
+        case CommandUI::command::help:
+        case CommandUI::command::demo:
+        case CommandUI::command::options:
+        case CommandUI::command::about:
+        case CommandUI::command::licence:
+        case CommandUI::command::debug:
+        {
+            responses += "err not available in machine mode";
+            break;
+        }
+        case CommandUI::command::invalid:
+        default:
+        {
+            responses += "err not a valid command";
+        }
+    }
+
+    responses += '\n';
+}
+
 /** \brief Handles a command from the user and does something acordingly
  *
  * \param inputtedLine The line to parse
@@ -122,6 +483,17 @@ void CommandUI::handleCommand(const std::string &inputtedLine, Grid15::Grid &gri
         }
     };
 
+    constexpr auto invalidOptionError
+    {
+        [](const std::string &option)
+        {
+            std::cerr << termcolor::bold << termcolor::red;
+            std::cerr << "Sorry, but \"" << option << "\" is not a valid option. ";
+            std::cerr << termcolor::reset;
+            std::cerr << "Try typing \"options\" for a list." << "\n";
+        }
+    };
+
 
     if (easySlide && argsStream >> tile)//if command is a tile and easySlide on
     {
@@ -176,16 +548,59 @@ void CommandUI::handleCommand(const std::string &inputtedLine, Grid15::Grid &gri
                     std::clog << "(debug)Reseting defaultSaveFile" << "\n";
 
                 defaultSaveFile = {""};
+                journal.reset();
+                history.clear();
                 break;
             }
             case CommandUI::command::slide:
             {
                 if (argsStream >> tile)
-                    Grid15::GridHelp::swapTile(tile, grid);
+                    swapTile(tile, grid);//not GridHelp::swapTile, so the move can be undone
                 else
                     invalidSyntaxError();
                 break;
             }
+            case CommandUI::command::moves:
+            {
+                std::getline(argsStream, input);//the rest of the line
+
+                if (input.find_first_not_of(" \t") != std::string::npos)
+                    slideMoves(input, grid);
+                else
+                    invalidSyntaxError();
+                break;
+            }
+            case CommandUI::command::undo:
+            case CommandUI::command::redo:
+            {
+                const bool undoing {parsedCommand == CommandUI::command::undo};
+                const std::uint8_t tileNum {undoing ? history.undo(grid) : history.redo(grid)};
+
+                if (tileNum == Grid15::Grid::NO_TILE)
+                    std::cout << (undoing ? "Nothing to undo." : "Nothing to redo.") << "\n";
+                else
+                {
+                    wantsToExit = {Grid15::GridHelp::hasWon(grid) && autoExit};//a redo (or undo) can win too
+
+                    const std::uint8_t move {undoing ? Grid15::MoveJournal::UNDO : Grid15::MoveJournal::REDO};//journaled as an undo or redo, not a new move
+                    autoSaveMoves(&move, 1, grid);
+
+                    if (autoGrid)
+                    {
+                        std::cout << std::endl;
+                        printGrid(grid);
+                        std::cout << std::endl;
+                    }
+
+                    if (Grid15::GridHelp::hasWon(grid))
+                    {
+                        std::cout << termcolor::green << termcolor::bold;
+                        std::cout << "YOU WON!!!" << "\n";
+                        std::cout << termcolor::reset;
+                    }
+                }
+                break;
+            }
             case CommandUI::command::print:
             {
                 if (argsStream >> input)
@@ -234,7 +649,10 @@ void CommandUI::handleCommand(const std::string &inputtedLine, Grid15::Grid &gri
             case CommandUI::command::enable:
             {
                 if (argsStream >> input)
-                    handleOptions(input, true);
+                {
+                    if (!handleOptions(input, true))
+                        invalidOptionError(input);
+                }
                 else
                     invalidSyntaxError();
                 break;
@@ -242,7 +660,10 @@ void CommandUI::handleCommand(const std::string &inputtedLine, Grid15::Grid &gri
             case CommandUI::command::disable:
             {
                 if (argsStream >> input)
-                    handleOptions(input, false);
+                {
+                    if (!handleOptions(input, false))
+                        invalidOptionError(input);
+                }
                 else
                     invalidSyntaxError();
                 break;
@@ -336,6 +757,9 @@ void CommandUI::displayHelp()
 
     cout << "newgame\t\tEnds the current game and starts a new one" << "\n";
     cout << "slide\tnum\tSlides the tile with the number given" << "\n";
+    cout << "moves\tstr\tMakes many moves at once, as tiles or U, D, L and R (the way the empty space moves)" << "\n";
+    cout << "undo\t\tTakes back the last move" << "\n";
+    cout << "redo\t\tMakes the last move taken back again" << "\n";
     cout << "print\tstr\tPrints the current \"grid\" or the \"goal\" grid" << "\n";
     cout << endl;
 
@@ -521,6 +945,7 @@ void CommandUI::displayOptions()
     cout << "autoGrid bool\tIf enabled, autoprints the grid after certain commands. Enabled by default." << "\n";
     cout << "autoExit bool\tIf enabled, automatically exits the game after you win. Disabled by default." << "\n";
     cout << "easySlide bool\tAllows you to just type in a number rather than \"slide\" first. Enabled by default." << "\n";
+    cout << "journalSave bool\tIf enabled, autosaves by adding each move to a journal next to the savefile. Enabled by default." << "\n";
     cout << endl;
 }
 
@@ -528,8 +953,9 @@ void CommandUI::displayOptions()
  *
  * \param option The option string to set
  * \param optionSetting Turn it on or off
+ * \return If the option exists (true) or not (false)
  */
-void CommandUI::handleOptions(const std::string &option, bool optionSetting)
+bool CommandUI::handleOptions(const std::string &option, bool optionSetting)
 {
     if      (option == "autoSave")
         autoSave = {optionSetting};
@@ -539,13 +965,28 @@ void CommandUI::handleOptions(const std::string &option, bool optionSetting)
         autoExit = {optionSetting};
     else if (option == "easySlide")
         easySlide = {optionSetting};
-    else
+    else if (option == "journalSave")
     {
-        std::cerr << termcolor::bold << termcolor::red;
-        std::cerr << "Sorry, but \"" << option << "\" is not a valid option. ";
-        std::cerr << termcolor::reset;
-        std::cerr << "Try typing \"options\" for a list." << "\n";
+        journalSave = {optionSetting};
+
+        if (!journalSave && journal)//fold the journal into the savefile so it no longer needs replaying
+        {
+            try
+            {
+                journal->close();
+            }
+            catch (std::ios_base::failure &e)
+            {
+                std::cerr << "Warning: The journal could not be closed. Try saving again using \"save.\"" << std::endl;
+            }
+
+            journal.reset();
+        }
     }
+    else
+        return false;
+
+    return true;
 }
 
 /** \brief Handles the debug commands. Only avaliable if ProgramStuff::Build::DEBUG equals true
@@ -686,7 +1127,10 @@ void CommandUI::saveGame(const std::string &saveFile, const Grid15::Grid &grid)
 
     try
     {
-        Grid15::GridHelp::save(saveFile, grid);
+        journal.reset();
+
+        Grid15::GridHelp::save(saveFile, grid, history);
+        Grid15::MoveJournal::discard(saveFile);//the journal belongs to the old save
 
         std::cout << termcolor::green;
         std::cout << "Save Complete!";
@@ -719,7 +1163,8 @@ void CommandUI::loadGame(const std::string &saveFile, Grid15::Grid &grid)
 
     try
     {
-        Grid15::GridHelp::load(saveFile, grid);
+        Grid15::MoveJournal::load(saveFile, grid, history);//also replays any moves journaled since the save
+        journal.reset();
 
         std::cout << termcolor::green;
         std::cout << "Load Sucessfull!";
@@ -751,6 +1196,85 @@ void CommandUI::loadGame(const std::string &saveFile, Grid15::Grid &grid)
     }
 }
 
+/** \brief Autosaves after one or more moves, if autoSave is on and there is a default save file
+ *
+ * \param moves The moves, in order: the tiles slid, or Grid15::MoveJournal::UNDO or Grid15::MoveJournal::REDO
+ * \param count How many moves there are
+ * \param grid The Grid after the moves
+ */
+void CommandUI::autoSaveMoves(const std::uint8_t *moves, const std::size_t count, const Grid15::Grid &grid)
+{
+    if (autoSave && (defaultSaveFile != ""))//if auto save is on and there is a default save file
+    {
+        try
+        {
+            if (!journalSave)
+                Grid15::GridHelp::save(defaultSaveFile, grid, history);//silent save (dosent use saveGame)
+            else if (journal && journal->getSaveFile() == defaultSaveFile)
+                journal->record(moves, count);//one byte a move instead of the whole grid
+            else
+                journal = {std::make_unique<Grid15::MoveJournal>(defaultSaveFile, grid, &history)};
+
+            if constexpr (ProgramStuff::Build::DEBUG)
+                std::clog << "(debug)Autosaved the game" << "\n";
+        }
+        catch (std::invalid_argument &e)
+        {
+            journal.reset();//the journal lost track of the game; start over with a fresh snapshot next time
+        }
+        catch (std::ios_base::failure &e)
+        {
+            journal.reset();//start over with a fresh snapshot next time
+
+            std::cerr << "Warning: The autosave failed. Try saving to a new location using \"save,\" or change file permissions." << std::endl;
+        }
+    }
+}
+
+/** \brief Makes a sequence of moves, all or none of them, then autosaves and prints the grid once
+ *
+ * \param moves The moves (see Grid15::GridHelp::parseMoves)
+ * \param grid The Grid to use
+ */
+void CommandUI::slideMoves(const std::string &moves, Grid15::Grid &grid)
+{
+    std::vector<std::uint8_t> tiles {};
+
+    try
+    {
+        tiles = {Grid15::GridHelp::parseMoves(moves, grid)};//checks every move before any is made
+    }
+    catch (std::invalid_argument &e)
+    {
+        std::cout << termcolor::bold << termcolor::red;
+        std::cout << "Sorry, but none of the moves were made. " << e.what();
+        std::cout << termcolor::reset;
+        std::cout << " Please try again." << "\n";
+        return;
+    }
+
+    for (const std::uint8_t tileNum : tiles)
+        history.slideUnchecked(tileNum, grid);//parseMoves checked every move
+
+    wantsToExit = {Grid15::GridHelp::hasWon(grid) && autoExit};//if the game is over and autoExit is on then exit
+
+    autoSaveMoves(tiles.data(), tiles.size(), grid);
+
+    if (autoGrid)
+    {
+        std::cout << std::endl;
+        printGrid(grid);
+        std::cout << std::endl;
+    }
+
+    if (Grid15::GridHelp::hasWon(grid))
+    {
+        std::cout << termcolor::green << termcolor::bold;
+        std::cout << "YOU WON!!!" << "\n";
+        std::cout << termcolor::reset;
+    }
+}
+
 /** \brief Swaps a tile
  *
  * \param tile The tile to swap
@@ -760,24 +1284,12 @@ void CommandUI::swapTile(const std::int64_t tile, Grid15::Grid &grid)
 {
     if (Grid15::GridHelp::validMove(tile, grid))//instead of a try catch block
     {
-        Grid15::GridHelp::swapTile(tile, grid);
+        const std::uint8_t tileNum = static_cast<std::uint8_t> (tile);
+        history.slide(tileNum, grid);
 
         wantsToExit = {Grid15::GridHelp::hasWon(grid) && autoExit};//if the game is over and autoExit is on then exit
 
-        if (autoSave && (defaultSaveFile != ""))//if auto save is on and there is a default save file
-        {
-            try
-            {
-                Grid15::GridHelp::save(defaultSaveFile, grid);//silent save (dosent use saveGame)
-
-                if constexpr (ProgramStuff::Build::DEBUG)
-                    std::clog << "(debug)Autosaved the game" << "\n";
-            }
-            catch (std::ios_base::failure &e)
-            {
-                std::cerr << "Warning: The autosave failed. Try saving to a new location using \"save,\" or change file permissions." << std::endl;
-            }
-        }
+        autoSaveMoves(&tileNum, 1, grid);
     }
     else
     {
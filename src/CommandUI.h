@@ -26,10 +26,14 @@
 
 #include "ProgramStuff.h"
 #include "Grid15/Grid.h"
+#include "Grid15/MoveJournal.h"
+#include "Grid15/MoveHistory.h"
 
 #include <cstdint>
+#include <cstddef>
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 
 /** \class CommandUI
@@ -60,6 +64,18 @@
  *          <td>Slides the tile with the number given</td>
  *      </tr>
  *      <tr>
+ *          <td>moves str</td>
+ *          <td>Makes many moves at once, as tiles or U, D, L and R (the way the empty space moves)</td>
+ *      </tr>
+ *      <tr>
+ *          <td>undo</td>
+ *          <td>Takes back the last move</td>
+ *      </tr>
+ *      <tr>
+ *          <td>redo</td>
+ *          <td>Makes the last move taken back again</td>
+ *      </tr>
+ *      <tr>
  *          <td>print str</td>
  *          <td>Prints the current "grid" or the "goal" grid</td>
  *      </tr>
@@ -97,6 +113,9 @@
  *      </tr>
  * </table>
  *
+ * When stdin is not a terminal, or 15Slide is started with "--machine" or "-m", CommandUI::startMachine is used instead of
+ * CommandUI::start: the same commands, answered with one plain "ok ..." or "err ..." line each.
+ *
  * \author John Jekel
  * \date 2017-2018
  */
@@ -108,6 +127,10 @@ class CommandUI
 
         void handleCommand(const std::string &inputtedLine, Grid15::Grid &grid);
 
+        static bool inputIsTerminal();
+        static bool wantsMachineMode(int argc, char *argv[]);
+        void startMachine(Grid15::Grid &grid);//start the ui for scripts
+
 
         /* Grid Management */
         static void printGrid(Grid15::Grid::gridArray_t grid);
@@ -122,27 +145,35 @@ class CommandUI
 
         // Options (with defaults)
         static void displayOptions();
-        void handleOptions(const std::string &option, bool optionSetting);
+        bool handleOptions(const std::string &option, bool optionSetting);
         bool autoSave   {ProgramStuff::AUTOSAVE_ON_SLIDE_DEFAULT}; ///<Autosave to last savefile
         bool autoGrid   {true}; ///<Autoprint the grid
         bool autoExit   {false};///<Exit the game on win automatically
         bool easySlide  {true}; ///<Slide a tile without having to type "slide" first
+        bool journalSave{ProgramStuff::JOURNAL_AUTOSAVE_DEFAULT};///<Autosave by appending moves to a journal instead of rewriting the savefile
 
         void handleDebug (const std::string &inputtedLine);
 
 
         /* Grid Management */
         std::string defaultSaveFile {""};///<The savefile to use for autoSaving, found during CommandUI::saveGame or CommandUI::loadGame
+        std::unique_ptr<Grid15::MoveJournal> journal {};///<The journal for defaultSaveFile, started on the first autosave if journalSave is on
         void saveGame(const std::string &saveFile, const Grid15::Grid &grid);
         void loadGame(const std::string &saveFile, Grid15::Grid &grid);
 
+        Grid15::MoveHistory history {};///<The moves of the current game, for undo and redo
         void swapTile(const std::int64_t tile, Grid15::Grid &grid);
+        void slideMoves(const std::string &moves, Grid15::Grid &grid);
+        void autoSaveMoves(const std::uint8_t *moves, const std::size_t count, const Grid15::Grid &grid);
 
 
         /* Command Handling */
         bool wantsToExit {false};///<Whether the user wants to exit or not; used internally to exit CommandUI::start
         enum class command;
 
+        static constexpr std::size_t MACHINE_BUFFER_SIZE {1 << 16};///<How much input machine mode reads, and output it buffers, at once
+        void handleMachineCommand(const char *first, const char *last, Grid15::Grid &grid, std::string &responses);
+
         static const std::unordered_map<std::string, CommandUI::command> commandMap;
 };
 
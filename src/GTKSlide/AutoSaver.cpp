@@ -0,0 +1,290 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "GTKSlide/AutoSaver.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/MoveJournal.h"
+#include "Grid15/MoveHistory.h"
+
+#include <gtkmm.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <ios>
+#include <utility>
+#include <exception>
+
+
+namespace GTKSlide
+{
+    ///Starts the writer thread
+    AutoSaver::AutoSaver()
+    {
+        dispatcher.connect(sigc::mem_fun(*this, &AutoSaver::deliver));
+        writer = {std::thread {&AutoSaver::run, this}};
+    }
+
+    ///Finishes every autosave asked for, then stops the writer thread
+    AutoSaver::~AutoSaver()
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex};
+            stopping = {true};
+        }
+
+        wake.notify_one();
+        writer.join();
+    }
+
+    /** \brief Asks for the game to be autosaved after a move; returns right away
+     *
+     * The MoveHistory is only copied when the save file is rewritten or a journal started; otherwise only the move is passed on.
+     * If the journal is dropped before the moves reach it, the writer asks for the history again (see AutoSaver::supplyHistory).
+     *
+     * \param saveFile The save file
+     * \param grid The game after the move
+     * \param history The moves of the game, including this one; must last as long as the AutoSaver, or until AutoSaver::reset
+     * \param move The tile that was slid, or Grid15::MoveJournal::UNDO or Grid15::MoveJournal::REDO
+     * \param journal Whether to journal the move (see Grid15::MoveJournal) or rewrite the save file
+     */
+    void AutoSaver::save(const std::string &saveFile, const Grid15::Grid &grid, const Grid15::MoveHistory &history, const std::uint8_t move,
+                         const bool journal)
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex};
+
+            if (pendingFile != saveFile)
+                pendingTiles.clear();//the moves belong to another save; the writer starts a new journal for this one
+
+            pending = {true};
+            pendingFile = {saveFile};
+            pendingGrid = {grid};
+            pendingTiles.push_back(move);
+
+            if (!journal || journaledFile != saveFile || historyWanted)//the whole history is written, not just the move
+            {
+                pendingHistory = {history};
+                pendingHasHistory = {true};
+                historyWanted = {false};
+            }
+            pendingJournal = {journal};
+            ++requested;
+        }
+
+        latestHistory = {&history};
+
+        wake.notify_one();
+    }
+
+    ///Waits for every autosave asked for to be written, then reports the result with AutoSaver::signalFinished right away
+    void AutoSaver::flush()
+    {
+        {
+            std::unique_lock<std::mutex> lock {mutex};
+            idle.wait(lock, [this] {return !pending && !busy;});
+
+            while (historyWanted)//the writer set the last autosave aside until it has the history
+            {
+                supplyHistory();
+                idle.wait(lock, [this] {return !pending && !busy;});
+            }
+        }
+
+        deliver();
+    }
+
+    ///Waits for every autosave asked for to be written and forgets them and the journal, for when the save file is written or changed directly
+    void AutoSaver::reset()
+    {
+        std::unique_lock<std::mutex> lock {mutex};
+        idle.wait(lock, [this] {return !pending && !busy;});
+
+        journal.reset();//the writer is waiting, so this is safe
+        journaledFile = {""};
+        pendingFile = {""};
+        historyWanted = {false};
+        failed = {false};
+        failureReported = {false};
+        reported = {written};
+        latestHistory = {nullptr};
+    }
+
+    ///The writer thread: takes the latest autosave and writes it until told to stop
+    void AutoSaver::run()
+    {
+        std::unique_lock<std::mutex> lock {mutex};
+
+        while (true)
+        {
+            wake.wait(lock, [this] {return pending || stopping;});
+
+            if (!pending)
+                break;//stopping, and everything is written
+
+            //take everything asked for so far and write it without holding the lock
+            const std::string saveFile {pendingFile};
+            const Grid15::Grid grid {pendingGrid};
+            Grid15::MoveHistory history {};
+            const bool hasHistory {pendingHasHistory};
+            std::vector<std::uint8_t> tiles {};
+            tiles.swap(pendingTiles);
+            const bool useJournal {pendingJournal};
+            const std::uint64_t generation {requested};
+
+            if (hasHistory)
+                history = {std::move(pendingHistory)};
+
+            pending = {false};
+            pendingHasHistory = {false};
+
+            if (!hasHistory && !(useJournal && journal && journal->getSaveFile() == saveFile))
+            {
+                //the journal was dropped after these moves were asked for, so a full snapshot is needed; nothing failed, so ask for the history
+                historyWanted = {true};
+                idle.notify_all();
+                dispatcher.emit();
+                continue;
+            }
+
+            busy = {true};
+            lock.unlock();
+
+            const bool worked {write(saveFile, grid, hasHistory ? &history : nullptr, tiles, useJournal)};
+
+            lock.lock();
+            busy = {false};
+            journaledFile = {journal ? journal->getSaveFile() : ""};
+
+            if (worked)
+                written = {generation};
+            else
+                failed = {true};
+
+            idle.notify_all();
+
+            if (!pending || !worked)
+                dispatcher.emit();//only wake the main loop when caught up, or to report a failure
+        }
+    }
+
+    /** \brief Writes an autosave; runs on the writer thread
+     *
+     * \param saveFile The save file
+     * \param grid The latest Grid
+     * \param history The latest MoveHistory, or nullptr if it was not copied because the journal is open and only needs the moves
+     * \param tiles The moves made since the last write
+     * \param useJournal Whether to journal the moves or rewrite the save file
+     * \return Whether the write worked
+     */
+    bool AutoSaver::write(const std::string &saveFile, const Grid15::Grid &grid, const Grid15::MoveHistory *history, const std::vector<std::uint8_t> &tiles,
+                          const bool useJournal)
+    {
+        try
+        {
+            if (useJournal && journal && journal->getSaveFile() == saveFile)
+            {
+                journal->record(tiles.data(), tiles.size());
+                return true;
+            }
+
+            if (!useJournal)
+            {
+                if (journal)//the journal would be replayed on top of the new save
+                {
+                    Grid15::MoveJournal::discard(journal->getSaveFile());
+                    journal.reset();
+                }
+
+                Grid15::GridHelp::save(saveFile, grid, *history);
+            }
+            else
+                journal = {std::make_unique<Grid15::MoveJournal>(saveFile, grid, history)};
+
+            return true;
+        }
+        catch (std::exception &e)//std::ios_base::failure, or std::invalid_argument if the journal lost track of the game
+        {
+            journal.reset();//start over with a fresh snapshot next time
+            return false;
+        }
+    }
+
+    ///Reports the latest result with AutoSaver::signalFinished; runs on the main loop
+    void AutoSaver::deliver()
+    {
+        bool hasFailed {false};
+        bool caughtUp {false};
+
+        {
+            std::lock_guard<std::mutex> lock {mutex};
+
+            if (historyWanted)
+            {
+                supplyHistory();
+                return;//reported once the writer catches up
+            }
+
+            hasFailed = {failed};
+            failed = {false};
+
+            caughtUp = {!pending && !busy && written == requested && written != reported};
+            reported = {written};
+        }
+
+        if (hasFailed)
+        {
+            if (!failureReported)//once is enough; the save file is already given up on until AutoSaver::reset
+            {
+                failureReported = {true};
+                finished.emit(false);
+            }
+        }
+        else if (caughtUp)
+            finished.emit(true);
+    }
+
+    /** \brief Gives the writer a copy of the latest MoveHistory for the autosave it set aside, and starts it again; runs on the main loop
+     *
+     * AutoSaver::mutex must be held
+     */
+    void AutoSaver::supplyHistory()
+    {
+        historyWanted = {false};
+
+        if (latestHistory == nullptr || pendingFile.empty())
+            return;
+
+        pendingHistory = {*latestHistory};
+        pendingHasHistory = {true};
+        pending = {true};
+        wake.notify_one();
+    }
+}
@@ -0,0 +1,109 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef AUTOSAVER_H
+#define AUTOSAVER_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/MoveJournal.h"
+#include "Grid15/MoveHistory.h"
+
+#include <gtkmm.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+namespace GTKSlide
+{
+    /** \class AutoSaver
+     *
+     * \brief Autosaves on a background thread so tile clicks never wait on the disk
+     *
+     * Moves requested while a write is running are merged, so a burst of clicks becomes one write of the latest Grid (or one write
+     * of the moves to the journal, see Grid15::MoveJournal). Results come back on the GTK main loop through AutoSaver::signalFinished.
+     *
+     * Must be created on the GTK main loop's thread.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class AutoSaver
+    {
+        public:
+            AutoSaver();
+            ~AutoSaver();
+
+            AutoSaver(const AutoSaver &other) = delete;
+            AutoSaver &operator=(const AutoSaver &other) = delete;
+
+            void save(const std::string &saveFile, const Grid15::Grid &grid, const Grid15::MoveHistory &history, const std::uint8_t move, const bool journal);
+            void flush();
+            void reset();
+
+            ///Emitted on the main loop with true once every autosave asked for is written, or with false if one failed
+            sigc::signal<void, bool> &signalFinished() {return finished;}
+
+        private:
+            void run();
+            bool write(const std::string &saveFile, const Grid15::Grid &grid, const Grid15::MoveHistory *history, const std::vector<std::uint8_t> &tiles,
+                       const bool journal);
+            void deliver();
+            void supplyHistory();
+
+            sigc::signal<void, bool> finished {};   ///<See AutoSaver::signalFinished
+            Glib::Dispatcher dispatcher {};         ///<Wakes the main loop to call AutoSaver::deliver after a write
+
+            //guarded by mutex
+            std::mutex mutex {};                    ///<Guards everything shared with the writer thread
+            std::condition_variable wake {};        ///<Wakes the writer when there is something to save or it should stop
+            std::condition_variable idle {};        ///<Wakes AutoSaver::flush when a write finishes
+            bool pending {false};                   ///<Whether there is an autosave the writer has not started
+            bool busy {false};                      ///<Whether the writer is writing
+            bool stopping {false};                  ///<Whether the writer should stop once everything is written
+            bool failed {false};                    ///<Whether a write failed since the last AutoSaver::deliver
+            std::string pendingFile {};             ///<The save file of the pending autosave
+            Grid15::Grid pendingGrid {};            ///<The latest Grid to save
+            Grid15::MoveHistory pendingHistory {};  ///<The latest MoveHistory to save, only copied when the writer will need it
+            bool pendingHasHistory {false};         ///<Whether AutoSaver::pendingHistory is up to date
+            std::vector<std::uint8_t> pendingTiles {};///<The moves made since the writer last started, for the journal
+            bool pendingJournal {false};            ///<Whether to journal the pending autosave
+            bool historyWanted {false};             ///<Whether the writer set aside the pending autosave because the journal was dropped and it needs a full snapshot
+            std::uint64_t requested {0};            ///<How many autosaves were asked for
+            std::uint64_t written {0};              ///<Which autosave (by AutoSaver::requested) is on disk
+            std::string journaledFile {};           ///<The save file AutoSaver::journal is open for; empty if there is none
+
+            std::uint64_t reported {0};             ///<Which autosave AutoSaver::signalFinished last reported; main loop only
+            bool failureReported {false};           ///<Whether AutoSaver::signalFinished reported a failure since the last AutoSaver::reset; main loop only
+            const Grid15::MoveHistory *latestHistory {nullptr};///<The MoveHistory given to the last AutoSaver::save, for AutoSaver::supplyHistory; main loop only
+            std::unique_ptr<Grid15::MoveJournal> journal {};///<The journal; writer thread only, except when idle
+            std::thread writer {};                  ///<The writer thread; started last
+    };
+}
+
+#endif //AUTOSAVER_H
@@ -27,6 +27,7 @@
 #include "ProgramStuff.h"//needed for about dialog and filesystem checks
 #include "Grid15/Grid.h"
 #include "Grid15/GridHelp.h"
+#include "Grid15/MoveJournal.h"
 #include "GTKSlide/GTKSlide.h"
 #include "GTKSlide/SlideFileDialog.h"
 #include "GTKSlide/SaveManager.h"
@@ -122,6 +123,12 @@ namespace GTKSlide
         actionGroup->add_action("load", sigc::mem_fun(*this, &MainWindow::onMenuBarLoad));
         applicationPtr->set_accel_for_action("actionGroup.load", "<Primary>l");
 
+        actionGroup->add_action("undo", sigc::mem_fun(tileGrid, &TileGrid::undo));
+        applicationPtr->set_accel_for_action("actionGroup.undo", "<Primary>z");
+
+        actionGroup->add_action("redo", sigc::mem_fun(tileGrid, &TileGrid::redo));
+        applicationPtr->set_accel_for_action("actionGroup.redo", "<Primary><Shift>z");
+
         actionGroup->add_action("exit", [this]
         {
             //lambda calls exit function (same one as x button)
@@ -179,6 +186,8 @@ namespace GTKSlide
     ///Resets the grid and handles the old one if it is not saved
     void MainWindow::onMenuBarNewGame()
     {
+        saveManager->autoSaver.flush();//finish autosaving so SaveManager::isSaved is up to date
+
         if (!saveManager->isSaved)
         {
             switch (createNotSavedDialogAndRun())
@@ -194,6 +203,8 @@ namespace GTKSlide
                     //reset previous save file
                     saveManager->saveFile = {""};
                     saveManager->isSaved = {false};
+                    saveManager->autoSaver.reset();
+                    saveManager->history.clear();
 
                     (*gridPtr) = {Grid15::GridHelp::generateRandomGrid()};
 
@@ -211,6 +222,8 @@ namespace GTKSlide
             //reset previous save file
             saveManager->saveFile = {""};
             saveManager->isSaved = {false};
+            saveManager->autoSaver.reset();
+            saveManager->history.clear();
 
             (*gridPtr) = {Grid15::GridHelp::generateRandomGrid()};
 
@@ -228,7 +241,10 @@ namespace GTKSlide
         {
             try
             {
-                Grid15::GridHelp::save(saveManager->saveFile, *gridPtr);//FIXME error handeling needed
+                saveManager->autoSaver.reset();
+
+                Grid15::GridHelp::save(saveManager->saveFile, *gridPtr, saveManager->history);//FIXME error handeling needed
+                Grid15::MoveJournal::discard(saveManager->saveFile);//the journal belongs to the old save
                 return true;
             }
             catch (std::ios_base::failure &e)
@@ -268,7 +284,10 @@ namespace GTKSlide
                 {
                     try
                     {
-                        Grid15::GridHelp::save(fileName, *gridPtr);
+                        saveManager->autoSaver.reset();
+
+                        Grid15::GridHelp::save(fileName, *gridPtr, saveManager->history);
+                        Grid15::MoveJournal::discard(fileName);//the journal belongs to the old save
 
                         //we only get here if the file works
                         saveManager->saveFile = {fileName};
@@ -329,6 +348,8 @@ namespace GTKSlide
     /// \brief Loads the grid from a file and updates MainWindow::saveManager
     void MainWindow::onMenuBarLoad()
     {
+        saveManager->autoSaver.flush();//finish autosaving so SaveManager::isSaved is up to date
+
         if (!saveManager->isSaved)
         {
             switch (createNotSavedDialogAndRun())
@@ -355,7 +376,9 @@ namespace GTKSlide
         {
             try
             {
-                Grid15::GridHelp::load(loadDialog.get_filename(), *gridPtr);
+                saveManager->autoSaver.reset();//nothing may be writing the file while it is read
+
+                Grid15::MoveJournal::load(loadDialog.get_filename(), *gridPtr, saveManager->history);//also replays any moves journaled since the save
 
                 //we only get here if the file works
                 saveManager->saveFile = {loadDialog.get_filename()};
@@ -391,6 +414,8 @@ namespace GTKSlide
      */
     bool MainWindow::exit(GdkEventAny* /*event*/)
     {
+        saveManager->autoSaver.flush();//finish autosaving so SaveManager::isSaved is up to date
+
         if (!saveManager->isSaved)
         {
             switch (createNotSavedDialogAndRun())
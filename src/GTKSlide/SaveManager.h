@@ -25,6 +25,8 @@
 
 
 #include "ProgramStuff.h"//just used for autosave
+#include "GTKSlide/AutoSaver.h"
+#include "Grid15/MoveHistory.h"
 
 #include <string>
 
@@ -44,6 +46,9 @@ namespace GTKSlide
             std::string saveFile    {""};                                       ///<The save file
             bool isSaved            {false};                                    ///<Whether the file is saved or not currently
             bool autoSave           {ProgramStuff::AUTOSAVE_ON_SLIDE_DEFAULT};  ///<Whether to autosave or not
+            bool journalSave        {ProgramStuff::JOURNAL_AUTOSAVE_DEFAULT};   ///<Whether to autosave by journaling moves instead of rewriting the save file
+            AutoSaver autoSaver     {};                                         ///<Writes autosaves in the background
+            Grid15::MoveHistory history {};                                     ///<The moves of the game, saved with it, for undo and redo
     };
 }
 
@@ -28,10 +28,12 @@
 #include "GTKSlide/GTKSlide.h"
 #include "Grid15/Grid.h"
 #include "Grid15/GridHelp.h"
+#include "Grid15/MoveJournal.h"
 #include "GTKSlide/SaveManager.h"
 
 #include <gtkmm.h>
 
+#include <cstdint>
 #include <iostream>
 #include <utility>
 
@@ -60,7 +62,7 @@ namespace GTKSlide
         //create grid of buttons
 
         //create the first row of tile buttons
-        for (std::uint_fast32_t i {0}; i < 4; ++i)
+        for (std::uint_fast32_t i {0}; i < Grid15::Grid::COLUMS; ++i)
         {
             //add signal handler
             gridButtons[twoDToSingle(0, i)].signal_clicked().connect
@@ -72,8 +74,8 @@ namespace GTKSlide
         }
 
         //attach remaning tiles underneath first row
-        for (std::uint_fast32_t i {1}; i < 4; ++i)
-            for (std::uint_fast32_t j {0}; j < 4; ++j)
+        for (std::uint_fast32_t i {1}; i < Grid15::Grid::ROWS; ++i)
+            for (std::uint_fast32_t j {0}; j < Grid15::Grid::COLUMS; ++j)
             {
                 //add signal handler
                 gridButtons[twoDToSingle(i, j)].signal_clicked().connect
@@ -85,6 +87,8 @@ namespace GTKSlide
                 attach_next_to(gridButtons[twoDToSingle(i, j)], gridButtons[twoDToSingle(i - 1, j)], Gtk::POS_BOTTOM, 1, 1);
             }
 
+        saveManager->autoSaver.signalFinished().connect(sigc::mem_fun(*this, &TileGrid::onAutoSaved));
+
         updateTiles();
     }
 
@@ -113,55 +117,86 @@ namespace GTKSlide
             if constexpr (ProgramStuff::Build::DEBUG)
                 std::clog << "(debug)Swapping tile... ";
 
-            Grid15::GridHelp::swapTile(y, x, *gridPtr);
-            saveManager->isSaved = {false};//just changed grid, must be unsaved
+            const std::uint8_t tile {(*gridPtr).gridArray[y][x]};
 
-            updateTiles();//FIXME just relable the 2 tiles instead
+            saveManager->history.slide(tile, *gridPtr);//not GridHelp::swapTile, so the move can be undone
+            afterMove(tile);
+        }
 
-            //check if user has won
-            if constexpr (ProgramStuff::Build::DEBUG)
-                std::clog << "Won: " << Grid15::GridHelp::hasWon(*gridPtr) << "\n";
+        if constexpr (ProgramStuff::Build::DEBUG)
+        {
+            std::clog << std::noboolalpha;
+            std::clog.flush();//sometimes nothing prints until clog is flushed
+        }
+    }
+
+    ///Undoes the last move, if there is one
+    void TileGrid::undo()
+    {
+        if (saveManager->history.undo(*gridPtr) != Grid15::Grid::NO_TILE)
+            afterMove(Grid15::MoveJournal::UNDO);//journaled as an undo, not a new move
+    }
 
-            if (Grid15::GridHelp::hasWon(*gridPtr))
-                displayWonDialog();
+    ///Redoes the last move undone, if there is one
+    void TileGrid::redo()
+    {
+        if (saveManager->history.redo(*gridPtr) != Grid15::Grid::NO_TILE)
+            afterMove(Grid15::MoveJournal::REDO);//journaled as a redo, not a new move
+    }
 
-            if (saveManager->autoSave && (saveManager->saveFile != ""))//if auto save is enabled and there is a save file
-            {
-                try
-                {
-                    Grid15::GridHelp::save(saveManager->saveFile, *gridPtr);
-
-                    //we only get here if above works
-                    saveManager->isSaved = {true};
-
-                    if constexpr (ProgramStuff::Build::DEBUG)
-                        std::clog << "(debug)Auto-saved the game" << "\n";
-                }
-                catch (std::ios_base::failure &e)
-                {
-                    //reset broken save file so user can fix in save as
-                    saveManager->saveFile = {""};
-                    saveManager->isSaved = {false};
-
-                    Gtk::MessageDialog errorDialog("Some this went wrong while auto-saving");
-                    errorDialog.set_title("Oh no!");
-
-                    errorDialog.set_secondary_text("Go to File -> Save As to choose a new save location");
-
-                    //display dialog
-                    errorDialog.set_transient_for(*parentPtr);
-                    errorDialog.show_all();
-                    errorDialog.present();
-                    errorDialog.run();
-                }
-            }
-        }
+    /** \brief Updates the tiles, checks for a win, and autosaves after a tile is slid
+     *
+     * \param move The tile that was slid, or Grid15::MoveJournal::UNDO or Grid15::MoveJournal::REDO
+     */
+    void TileGrid::afterMove(std::uint8_t move)
+    {
+        saveManager->isSaved = {false};//just changed grid, must be unsaved
 
+        updateTiles();//FIXME just relable the 2 tiles instead
 
+        //check if user has won
         if constexpr (ProgramStuff::Build::DEBUG)
+            std::clog << "Won: " << Grid15::GridHelp::hasWon(*gridPtr) << "\n";
+
+        if (Grid15::GridHelp::hasWon(*gridPtr))
+            displayWonDialog();
+
+        if (saveManager->autoSave && (saveManager->saveFile != ""))//if auto save is enabled and there is a save file
         {
-            std::clog << std::noboolalpha;
-            std::clog.flush();//sometimes nothing prints until clog is flushed
+            //written in the background, see TileGrid::onAutoSaved
+            saveManager->autoSaver.save(saveManager->saveFile, *gridPtr, saveManager->history, move, saveManager->journalSave);
+        }
+    }
+
+    /** The signal handler for when the AutoSaver of TileGrid::saveManager catches up or fails
+     *
+     * \param worked True if every autosave is written, false if one failed
+    */
+    void TileGrid::onAutoSaved(bool worked)
+    {
+        if (worked)
+        {
+            saveManager->isSaved = {true};
+
+            if constexpr (ProgramStuff::Build::DEBUG)
+                std::clog << "(debug)Auto-saved the game" << "\n";
+        }
+        else
+        {
+            //reset broken save file so user can fix in save as
+            saveManager->saveFile = {""};
+            saveManager->isSaved = {false};
+
+            Gtk::MessageDialog errorDialog("Some this went wrong while auto-saving");
+            errorDialog.set_title("Oh no!");
+
+            errorDialog.set_secondary_text("Go to File -> Save As to choose a new save location");
+
+            //display dialog
+            errorDialog.set_transient_for(*parentPtr);
+            errorDialog.show_all();
+            errorDialog.present();
+            errorDialog.run();
         }
     }
 
@@ -177,8 +212,8 @@ namespace GTKSlide
 ///Lables the Gtk::Button tiles based on gridPtr tile values
     void TileGrid::lableTiles()
     {
-        for (std::uint_fast32_t i {0}; i < 4; ++i)
-            for (std::uint_fast32_t j {0}; j < 4; ++j)
+        for (std::uint_fast32_t i {0}; i < Grid15::Grid::ROWS; ++i)
+            for (std::uint_fast32_t j {0}; j < Grid15::Grid::COLUMS; ++j)
             {
                 if ((*gridPtr).gridArray[i][j] != 0)
                     gridButtons[twoDToSingle(i, j)].set_label(std::to_string((*gridPtr).gridArray[i][j]));//set the lable to the tile number
@@ -190,8 +225,8 @@ namespace GTKSlide
 ///Sensitizes or desensitizes Gtk::Button the tiles based on if moving them would be valid, based on gridPtr tile values
     void TileGrid::sensitizeTiles()
     {
-        for (std::uint_fast32_t i {0}; i < 4; ++i)
-            for (std::uint_fast32_t j {0}; j < 4; ++j)
+        for (std::uint_fast32_t i {0}; i < Grid15::Grid::ROWS; ++i)
+            for (std::uint_fast32_t j {0}; j < Grid15::Grid::COLUMS; ++j)
                 gridButtons[twoDToSingle(i, j)].set_sensitive(Grid15::GridHelp::validMove(i, j, *gridPtr));//allows the button to be pressed if the move is valid
     }
 
@@ -230,7 +265,7 @@ namespace GTKSlide
      */
     std::pair<std::uint8_t, std::uint8_t> TileGrid::singleToTwoD(std::uint8_t coordinates)
     {
-        return std::pair<std::uint8_t, std::uint8_t> {coordinates / 4, coordinates % 4};
+        return std::pair<std::uint8_t, std::uint8_t> {coordinates / Grid15::Grid::COLUMS, coordinates % Grid15::Grid::COLUMS};
     }
 
     /** \brief A helper function to convert an x and y coordinate from 0 to 3 to a single number from 0 to 15
@@ -243,6 +278,6 @@ namespace GTKSlide
      */
     std::uint8_t TileGrid::twoDToSingle(std::uint8_t y, std::uint8_t x)
     {
-        return (y * 4) + x;
+        return (y * Grid15::Grid::COLUMS) + x;
     }
 }
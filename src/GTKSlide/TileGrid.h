@@ -52,13 +52,18 @@ namespace GTKSlide
             void lableTiles();
             void sensitizeTiles();
             void updateTiles();
+
+            void undo();
+            void redo();
         protected:
             //not smart pointer because window will be on stack
             Gtk::Window *parentPtr {};///<A pointer to the parent window to call various dialogs set_transient_for()
             std::shared_ptr<Grid15::Grid> gridPtr {};///<A pointer to the grid to use
 
             void on_tile_clicked(std::uint8_t coordinates);
-            std::unique_ptr<Gtk::Button[]> gridButtons {new Gtk::Button [16]};///<The array of buttons which represent tiles
+            void onAutoSaved(bool worked);
+            void afterMove(std::uint8_t move);
+            std::unique_ptr<Gtk::Button[]> gridButtons {new Gtk::Button [Grid15::Grid::CELLS]};///<The array of buttons which represent tiles
 
             void displayWonDialog();
             std::shared_ptr<SaveManager> saveManager {};///<A pointer to a SaveManager for managing autosaving
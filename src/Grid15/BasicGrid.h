@@ -0,0 +1,350 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef BASICGRID_H
+#define BASICGRID_H
+
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    /** \brief The tables for a board with Rows rows and Colums colums, all made at compile time
+     *
+     * Cell (y * Colums) + x is the cell at y and x. Tiles are numbered 1 to CELLS - 1 in reading order on Layout::GOAL_GRID,
+     * with the no tile (0) last. Every size gets its own tables, so code using them needs no runtime size checks and its loops
+     * have constant bounds the compiler can unroll.
+     *
+     * Grid uses Layout<4, 4>; see BasicGrid for other sizes.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    template <std::size_t Rows, std::size_t Colums>
+    struct Layout
+    {
+        static_assert(Rows >= 2 && Colums >= 2, "a board needs at least 2 rows and 2 colums");
+        static_assert(Rows * Colums <= 256, "tiles must fit in std::uint8_t");
+
+        /* Sizes */
+        static constexpr std::size_t ROWS       {Rows};             ///<The number of rows
+        static constexpr std::size_t COLUMS     {Colums};           ///<The number of colums
+        static constexpr std::size_t CELLS      {Rows * Colums};    ///<The number of cells (and tiles, counting the no tile)
+        static constexpr std::size_t NO_TILE    {0};                ///<The number representing the lack of a tile
+        static constexpr std::size_t TILE_MAX   {CELLS - 1};        ///<The maximum tile number
+        static constexpr std::size_t Y_MAX      {Rows - 1};         ///<The maximum y coordinate
+        static constexpr std::size_t X_MAX      {Colums - 1};       ///<The maximum x coordinate
+
+
+        /* Typedefs */
+        typedef std::array<std::array<std::uint8_t, Colums>, Rows> gridArray_t;    ///<Tiles by [y][x]
+        typedef std::array<std::array<std::uint8_t, 2>, CELLS> index_t;            ///<[tile][0] is the y coordinate of a tile, [tile][1] the x
+        typedef std::array<std::array<std::uint8_t, 4>, CELLS> neighbours_t;       ///<The type used for Layout::NEIGHBOURS
+        typedef std::array<std::array<std::uint8_t, CELLS>, CELLS> distances_t;    ///<The type used for Layout::GOAL_DISTANCES
+
+
+        /* Packing */
+        //each tile takes the fewest bits that fit TILE_MAX, and a tile never spans two words
+        static constexpr std::size_t BITS {CELLS <= 16 ? 4 : (CELLS <= 32 ? 5 : (CELLS <= 64 ? 6 : (CELLS <= 128 ? 7 : 8)))};///<Bits per packed tile
+        static constexpr std::size_t TILES_PER_WORD {64 / BITS};                                            ///<Packed tiles in each std::uint64_t
+        static constexpr std::size_t WORDS {(CELLS + TILES_PER_WORD - 1) / TILES_PER_WORD};                 ///<std::uint64_t words per packed board
+        static constexpr std::uint64_t TILE_MASK {(std::uint64_t {1} << BITS) - 1};                         ///<The bits of one packed tile
+
+        typedef std::array<std::uint64_t, WORDS> packed_t;///<A packed board: cell c is in word c / TILES_PER_WORD, at bit (c % TILES_PER_WORD) * BITS
+
+
+        /* Tables */
+        /** \brief Makes Layout::GOAL_GRID
+         *
+         * \return Tiles 1 to TILE_MAX in reading order, then the no tile
+         */
+        static constexpr gridArray_t makeGoal()
+        {
+            gridArray_t goal {};
+
+            for (std::size_t cell {0}; cell < CELLS - 1; ++cell)
+                goal[cell / Colums][cell % Colums] = static_cast<std::uint8_t> (cell + 1);
+
+            goal[Y_MAX][X_MAX] = static_cast<std::uint8_t> (NO_TILE);
+            return goal;
+        }
+
+        /** \brief Makes Layout::NEIGHBOURS
+         *
+         * \return The cells next to each cell (up, down, left then right, skipping the edges); unused entries are CELLS
+         */
+        static constexpr neighbours_t makeNeighbours()
+        {
+            neighbours_t neighbours {};
+
+            for (std::size_t cell {0}; cell < CELLS; ++cell)
+            {
+                const std::size_t y {cell / Colums};
+                const std::size_t x {cell % Colums};
+                std::size_t count {0};
+
+                for (std::size_t i {0}; i < 4; ++i)
+                    neighbours[cell][i] = static_cast<std::uint8_t> (CELLS);
+
+                if (y > 0)
+                    neighbours[cell][count++] = static_cast<std::uint8_t> (cell - Colums);
+                if (y < Y_MAX)
+                    neighbours[cell][count++] = static_cast<std::uint8_t> (cell + Colums);
+                if (x > 0)
+                    neighbours[cell][count++] = static_cast<std::uint8_t> (cell - 1);
+                if (x < X_MAX)
+                    neighbours[cell][count++] = static_cast<std::uint8_t> (cell + 1);
+            }
+
+            return neighbours;
+        }
+
+        /** \brief Makes Layout::GOAL_DISTANCES
+         *
+         * \return How far each tile on each cell is from its goal cell, by [tile][cell]; always 0 for the no tile
+         */
+        static constexpr distances_t makeGoalDistances()
+        {
+            distances_t distances {};
+
+            for (std::size_t tile {1}; tile < CELLS; ++tile)
+            {
+                for (std::size_t cell {0}; cell < CELLS; ++cell)
+                {
+                    const std::size_t goalY {(tile - 1) / Colums};
+                    const std::size_t goalX {(tile - 1) % Colums};
+                    const std::size_t y {cell / Colums};
+                    const std::size_t x {cell % Colums};
+
+                    distances[tile][cell] = static_cast<std::uint8_t> ((y > goalY ? y - goalY : goalY - y) + (x > goalX ? x - goalX : goalX - x));
+                }
+            }
+
+            return distances;
+        }
+
+        /** \brief Packs a grid array
+         *
+         * \param gridArray The grid array; tiles must be from 0 to TILE_MAX
+         * \return The packed tiles
+         */
+        static constexpr packed_t pack(const gridArray_t &gridArray)
+        {
+            packed_t packed {};
+
+            for (std::size_t cell {0}; cell < CELLS; ++cell)
+                packed[cell / TILES_PER_WORD] |= std::uint64_t {gridArray[cell / Colums][cell % Colums]} << ((cell % TILES_PER_WORD) * BITS);
+
+            return packed;
+        }
+
+        /** \brief Unpacks a grid array packed with Layout::pack
+         *
+         * \param packed The packed tiles
+         * \return The grid array
+         */
+        static constexpr gridArray_t unpack(const packed_t &packed)
+        {
+            gridArray_t gridArray {};
+
+            for (std::size_t cell {0}; cell < CELLS; ++cell)
+                gridArray[cell / Colums][cell % Colums] = static_cast<std::uint8_t> ((packed[cell / TILES_PER_WORD] >> ((cell % TILES_PER_WORD) * BITS)) & TILE_MASK);
+
+            return gridArray;
+        }
+    };
+
+    /** \brief A board of any size, using the tables of Layout<Rows, Colums>
+     *
+     * Keeps a grid array and an index like Grid does, without the hash and metrics. Moves are checked against Layout::NEIGHBOURS
+     * and never throw; only the grid array constructor checks its argument.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    template <std::size_t Rows, std::size_t Colums>
+    class BasicGrid
+    {
+        public:
+            /* Typedefs */
+            typedef Layout<Rows, Colums> layout_t;                      ///<The tables for this size
+            typedef typename layout_t::gridArray_t gridArray_t;         ///<The type used for BasicGrid::gridArray
+            typedef typename layout_t::index_t index_t;                 ///<The type used for BasicGrid::index
+            typedef typename layout_t::packed_t packed_t;               ///<The type used by BasicGrid::pack
+
+
+            /* Tables */
+            static constexpr gridArray_t GOAL_GRID                          {layout_t::makeGoal()};             ///<How the grid array is when the game is won
+            static constexpr typename layout_t::neighbours_t NEIGHBOURS     {layout_t::makeNeighbours()};       ///<The cells next to each cell
+            static constexpr typename layout_t::distances_t GOAL_DISTANCES  {layout_t::makeGoalDistances()};    ///<How far each tile on each cell is from its goal
+            static constexpr packed_t PACKED_GOAL                           {layout_t::pack(GOAL_GRID)};        ///<The packed tiles of BasicGrid::GOAL_GRID
+
+
+            /* Setup */
+            ///Creates a BasicGrid at BasicGrid::GOAL_GRID
+            BasicGrid() : BasicGrid(GOAL_GRID, 0) {}
+
+            /** \brief Creates a BasicGrid from a grid array
+             *
+             * \param newGridArray The grid array
+             * \throw std::invalid_argument If the grid array does not have every tile exactly once
+             */
+            explicit BasicGrid(const gridArray_t &newGridArray) : BasicGrid(newGridArray, 0)
+            {
+                std::array<bool, layout_t::CELLS> seen {};
+
+                for (std::size_t cell {0}; cell < layout_t::CELLS; ++cell)
+                {
+                    const std::uint8_t tile {gridArray[cell / Colums][cell % Colums]};
+
+                    if (tile > layout_t::TILE_MAX || seen[tile])
+                        throw std::invalid_argument {"Grid invalid!"};
+
+                    seen[tile] = {true};
+                }
+            }
+
+            ///Unpacks a BasicGrid packed with BasicGrid::pack
+            static BasicGrid unpack(const packed_t &packed) {return BasicGrid {layout_t::unpack(packed), 0};}
+
+
+            /* Access */
+            ///Gets the cell (y * Colums) + x a tile is on
+            std::uint8_t cellOf(const std::uint8_t tile) const noexcept {return static_cast<std::uint8_t> ((index[tile][0] * Colums) + index[tile][1]);}
+            ///Gets the packed tiles (see Layout::pack)
+            packed_t pack() const noexcept {return layout_t::pack(gridArray);}
+
+
+            /* Moves */
+            /** \brief Checks if a tile is next to the no tile
+             *
+             * \param tile The tile
+             * \return If the tile can slide
+             */
+            bool validMove(const std::uint8_t tile) const noexcept
+            {
+                if (tile == layout_t::NO_TILE || tile > layout_t::TILE_MAX)
+                    return false;
+
+                const std::uint8_t tileCell {cellOf(tile)};
+
+                for (const std::uint8_t cell : NEIGHBOURS[cellOf(layout_t::NO_TILE)])
+                    if (cell == tileCell)
+                        return true;
+
+                return false;
+            }
+
+            /** \brief Slides a tile into the no tile if it can
+             *
+             * \param tile The tile
+             * \return If the tile was slid
+             */
+            bool swapTile(const std::uint8_t tile) noexcept
+            {
+                if (!validMove(tile))
+                    return false;
+
+                const std::array<std::uint8_t, 2> tileCoordinates {index[tile]};
+                const std::array<std::uint8_t, 2> noTileCoordinates {index[layout_t::NO_TILE]};
+
+                gridArray[noTileCoordinates[0]][noTileCoordinates[1]] = {tile};
+                gridArray[tileCoordinates[0]][tileCoordinates[1]] = {static_cast<std::uint8_t> (layout_t::NO_TILE)};
+                index[tile] = {noTileCoordinates};
+                index[layout_t::NO_TILE] = {tileCoordinates};
+
+                return true;
+            }
+
+
+            /* Information */
+            ///Checks if the grid array is BasicGrid::GOAL_GRID
+            bool hasWon() const noexcept {return gridArray == GOAL_GRID;}
+
+            ///Gets the sum of how far each tile (not the no tile) is from its goal
+            std::uint_fast32_t manhattanDistance() const noexcept
+            {
+                std::uint_fast32_t distance {0};
+
+                for (std::size_t tile {1}; tile < layout_t::CELLS; ++tile)
+                    distance += GOAL_DISTANCES[tile][cellOf(static_cast<std::uint8_t> (tile))];
+
+                return distance;
+            }
+
+            /** \brief Checks if BasicGrid::GOAL_GRID can be reached
+             *
+             * With an odd number of colums a move never changes the parity of the inversions, so it has to be even like the goal's.
+             * With an even number, a move up or down flips it, so the inversions plus the rows between the no tile and the bottom must be even.
+             *
+             * \return If the board is solvable
+             */
+            bool solvable() const noexcept
+            {
+                std::uint_fast32_t inversions {0};
+
+                for (std::size_t i {0}; i < layout_t::CELLS; ++i)
+                {
+                    const std::uint8_t first {gridArray[i / Colums][i % Colums]};
+
+                    if (first != layout_t::NO_TILE)
+                        for (std::size_t j {i + 1}; j < layout_t::CELLS; ++j)
+                            if (gridArray[j / Colums][j % Colums] != layout_t::NO_TILE && gridArray[j / Colums][j % Colums] < first)
+                                ++inversions;
+                }
+
+                if ((Colums % 2) == 1)
+                    return (inversions % 2) == 0;
+                else
+                    return ((inversions + (layout_t::Y_MAX - index[layout_t::NO_TILE][0])) % 2) == 0;
+            }
+
+
+            /* Comparison */
+            bool operator==(const BasicGrid &other) const noexcept {return gridArray == other.gridArray;}///<The index follows from the grid array
+            bool operator!=(const BasicGrid &other) const noexcept {return gridArray != other.gridArray;}///<The index follows from the grid array
+
+
+            /* Storage */
+            gridArray_t gridArray {};   ///<The tiles, by [y][x]
+            index_t index {};           ///<The coordinates of each tile; [tile][0] is y and [tile][1] is x
+
+        private:
+            ///Creates a BasicGrid from a grid array that is already known to be valid, and indexes it
+            BasicGrid(const gridArray_t &newGridArray, int) : gridArray(newGridArray)
+            {
+                for (std::size_t cell {0}; cell < layout_t::CELLS; ++cell)
+                {
+                    index[gridArray[cell / Colums][cell % Colums] % layout_t::CELLS] =
+                    {
+                        {static_cast<std::uint8_t> (cell / Colums), static_cast<std::uint8_t> (cell % Colums)}
+                    };
+                }
+            }
+    };
+}
+#endif //BASICGRID_H
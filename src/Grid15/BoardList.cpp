@@ -0,0 +1,138 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/BoardList.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/MappedFile.h"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <istream>
+#include <sstream>
+#include <algorithm>
+#include <iterator>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    namespace BoardList
+    {
+        /** \brief Reads a puzzle list from memory
+         *
+         * \param first The first character of the list
+         * \param last One past the last character of the list
+         * \return The boards, including ones that could not be read (see Entry::error)
+         */
+        std::vector<Entry> read(const char *first, const char *last)
+        {
+            std::vector<Entry> entries {};
+            entries.reserve(static_cast<std::size_t> (std::count(first, last, '\n')) + 1);//at most one board per line
+
+            //what may be around and between the numbers of a board
+            const auto separator {[](const char character) {return character == ' ' || character == ',' || character == '\t' || character == '\r';}};
+
+            std::size_t lineNumber {1};
+
+            for (const char *lineStart {first}; lineStart < last; ++lineNumber)
+            {
+                const char *lineEnd {static_cast<const char *> (std::memchr(lineStart, '\n', static_cast<std::size_t> (last - lineStart)))};
+                if (lineEnd == nullptr)
+                    lineEnd = {last};
+
+                const char *comment {static_cast<const char *> (std::memchr(lineStart, '#', static_cast<std::size_t> (lineEnd - lineStart)))};
+                const char *boardEnd {(comment == nullptr) ? lineEnd : comment};
+
+                //skip lines with nothing but separators
+                if (std::all_of(lineStart, boardEnd, separator))
+                {
+                    lineStart = {lineEnd + 1};
+                    continue;
+                }
+
+                entries.emplace_back();
+                Entry &entry {entries.back()};
+                entry.line = {lineNumber};
+
+                Grid::gridArray_t gridArray {};
+                const char *numbersEnd {GridHelp::parseGridArray(lineStart, boardEnd, gridArray)};
+
+                if (numbersEnd == nullptr || !std::all_of(numbersEnd, boardEnd, separator))
+                    entry.error = {"expected 16 numbers"};
+                else
+                {
+                    try
+                    {
+                        GridHelp::safeCopy(gridArray, entry.grid);
+                    }
+                    catch (std::invalid_argument &e)
+                    {
+                        entry.error = {e.what()};
+                    }
+                }
+
+                lineStart = {lineEnd + 1};
+            }
+
+            return entries;
+        }
+
+        /** \brief Reads a puzzle list from a stream
+         *
+         * \param input The stream to read to the end
+         * \return The boards, including ones that could not be read (see Entry::error)
+         */
+        std::vector<Entry> read(std::istream &input)
+        {
+            std::ostringstream contents {};
+
+            if (input.peek() != std::istream::traits_type::eof())//copying an empty stream sets failbit on contents
+                contents << input.rdbuf();
+
+            const std::string text {contents.str()};
+            return read(text.data(), text.data() + text.size());
+        }
+
+        /** \brief Reads a puzzle list from a file, by mapping it into memory
+         *
+         * \param file The file
+         * \return The boards, including ones that could not be read (see Entry::error)
+         * \throw std::ios_base::failure If the file cannot be opened
+         */
+        std::vector<Entry> readFile(const std::string &file)
+        {
+            std::size_t size {0};
+            const std::shared_ptr<const void> mapped {MappedFile::map(file, size, MappedFile::Access::SEQUENTIAL)};
+
+            const char *first {static_cast<const char *> (mapped.get())};
+            return read(first, first + size);
+        }
+    }
+}
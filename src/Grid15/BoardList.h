@@ -0,0 +1,67 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef BOARDLIST_H
+#define BOARDLIST_H
+
+
+#include "Grid15/Grid.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <istream>
+
+
+namespace Grid15
+{
+    /** \brief Bulk importers for puzzle lists in text
+     *
+     * A puzzle list has one board per line: 16 numbers from 0 to 15 (0 is the no tile), left to right and top to bottom, separated by
+     * spaces, tabs and/or commas. This is also the format of 15Slide save files. Blank lines and anything after a # are skipped, and
+     * both \\n and \\r\\n line endings work.
+     *
+     * Boards are parsed in place with GridHelp::parseGridArray, so nothing is allocated per line except for boards that have errors.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    namespace BoardList
+    {
+        /** \brief A board read from a puzzle list
+         *
+         * \author John Jekel
+         * \date 2018-2018
+         */
+        struct Entry
+        {
+            std::size_t line {0};       ///<The line the board was on, counting from 1
+            Grid grid {};               ///<The board; only valid if Entry::error is empty
+            std::string error {};       ///<Why the line could not be read, or empty
+        };
+
+        std::vector<Entry> read(const char *first, const char *last);
+        std::vector<Entry> read(std::istream &input);
+        std::vector<Entry> readFile(const std::string &file);
+    }
+}
+#endif //BOARDLIST_H
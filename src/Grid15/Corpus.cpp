@@ -0,0 +1,264 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/Corpus.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/PackedGrid.h"
+#include "Grid15/MappedFile.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    namespace
+    {
+        constexpr char FILE_MAGIC[8]            {"15SLCRP"};    ///<The first bytes of a corpus file
+        constexpr std::uint32_t BYTE_ORDER_MARK {0x01020304};   ///<Written as is, so files from computers with another byte order are noticed
+        constexpr std::uint32_t HAS_LENGTHS     {0x1};          ///<FileHeader::flags bit set when there is a length for each record
+        constexpr std::size_t BUFFER_RECORDS    {4096};         ///<How many records CorpusWriter keeps before writing them
+
+        /** \brief The start of a corpus file
+         */
+        struct FileHeader
+        {
+            char magic[8];                  ///<Always FILE_MAGIC
+            std::uint32_t version;          ///<Always Corpus::FILE_VERSION
+            std::uint32_t byteOrder;        ///<Always BYTE_ORDER_MARK
+            std::uint64_t count;            ///<How many records come after the header
+            std::uint32_t flags;            ///<HAS_LENGTHS, or 0
+            std::uint32_t reserved;         ///<Padding; 0
+            std::uint64_t checksum;         ///<The checksum of the records and then the lengths
+        };
+
+        //the records start right after the header, so this keeps them 8 byte aligned in the mapped file
+        static_assert(sizeof(FileHeader) == 40, "Corpus file header must not have extra padding");
+        static_assert(sizeof(Corpus::record_t) == 8, "Corpus records must be 8 bytes");
+    }
+
+    /* Corpus */
+    /** \brief Opens a corpus saved with CorpusWriter
+     *
+     * Only the header is checked here; see Corpus::verify to check the records against the checksum.
+     *
+     * \param file The file to open
+     * \throw std::ios_base::failure If the file cannot be opened or mapped
+     * \throw std::invalid_argument If the file is not a corpus file, is from another version, or is the wrong size for its header
+     */
+    Corpus::Corpus(const std::string &file)
+    {
+        std::size_t fileSize {0};
+        storage = {MappedFile::map(file, fileSize, MappedFile::Access::SEQUENTIAL)};
+
+        const std::uint8_t *data {static_cast<const std::uint8_t *> (storage.get())};
+
+        if (fileSize < sizeof(FileHeader))
+            throw std::invalid_argument {"Corpus file invalid!"};
+
+        FileHeader header {};
+        std::memcpy(&header, data, sizeof(FileHeader));
+
+        if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK)
+            throw std::invalid_argument {"Corpus file invalid!"};
+        if (header.version != FILE_VERSION)
+            throw std::invalid_argument {"Corpus file version unsupported!"};
+
+        const std::uint64_t recordSize {sizeof(record_t) + (((header.flags & HAS_LENGTHS) != 0) ? 1 : 0)};
+
+        if ((header.flags & ~HAS_LENGTHS) != 0 || header.count > (fileSize - sizeof(FileHeader)) / recordSize
+            || sizeof(FileHeader) + (header.count * recordSize) != fileSize)
+            throw std::invalid_argument {"Corpus file invalid!"};
+
+        count = static_cast<std::size_t> (header.count);
+        checksum = {header.checksum};
+        records = reinterpret_cast<const record_t *> (data + sizeof(FileHeader));
+
+        if ((header.flags & HAS_LENGTHS) != 0)
+            lengths = {data + sizeof(FileHeader) + (count * sizeof(record_t))};
+    }
+
+    /** \brief Unpacks one record
+     *
+     * \param record Which record, counting from 0
+     * \return The board
+     * \throw std::out_of_range If there is no such record
+     * \throw std::invalid_argument If the record is not a valid board
+     */
+    PackedGrid Corpus::at(const std::size_t record) const
+    {
+        if (record >= count)
+            throw std::out_of_range {"record invalid!"};
+
+        return PackedGrid {records[record]};
+    }
+
+    /** \brief Gets the optimal solution length of one record
+     *
+     * \param record Which record, counting from 0
+     * \return The length, or Corpus::UNKNOWN_LENGTH if it was not given or the file has no lengths
+     * \throw std::out_of_range If there is no such record
+     */
+    std::uint8_t Corpus::length(const std::size_t record) const
+    {
+        if (record >= count)
+            throw std::out_of_range {"record invalid!"};
+
+        return (lengths != nullptr) ? lengths[record] : UNKNOWN_LENGTH;
+    }
+
+    /** \brief Checks the records and lengths against the checksum in the header
+     *
+     * This reads the whole file
+     *
+     * \return If they match
+     */
+    bool Corpus::verify() const
+    {
+        std::uint64_t fileChecksum {MappedFile::checksum(reinterpret_cast<const std::uint8_t *> (records), count * sizeof(record_t))};
+
+        if (lengths != nullptr)
+            fileChecksum = {MappedFile::checksum(lengths, count, fileChecksum)};
+
+        return fileChecksum == checksum;
+    }
+
+
+    /* CorpusWriter */
+    /** \brief Creates (or replaces) a corpus file
+     *
+     * \param file The file to write
+     * \param newWithLengths If the optimal length of each board is written too
+     * \throw std::ios_base::failure From std::ofstream; if a file operation goes wrong
+     */
+    CorpusWriter::CorpusWriter(const std::string &file, const bool newWithLengths) : withLengths {newWithLengths}
+    {
+        fileStream.exceptions(fileStream.failbit | fileStream.badbit);//to throw exceptions if something goes wrong
+        fileStream.open(file, std::ios::binary | std::ios::trunc);
+
+        //room for the header, which is written once the count and checksum are known
+        const FileHeader header {};
+        fileStream.write(reinterpret_cast<const char *> (&header), sizeof(FileHeader));
+
+        buffer.reserve(BUFFER_RECORDS);
+        checksum = {MappedFile::CHECKSUM_START};
+    }
+
+    ///Closes the file if CorpusWriter::close was not called; errors are ignored, so call close to see them
+    CorpusWriter::~CorpusWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (std::exception &)
+        {
+            //nothing can be done about it here
+        }
+    }
+
+    /** \brief Adds a board
+     *
+     * \param grid The board
+     * \param length The optimal solution length, or Corpus::UNKNOWN_LENGTH; ignored unless lengths are written
+     * \throw std::invalid_argument If the grid array is not valid
+     * \throw std::ios_base::failure From std::ofstream; if a file operation goes wrong
+     */
+    void CorpusWriter::add(const Grid &grid, const std::uint8_t length)
+    {
+        add(PackedGrid {grid}, length);
+    }
+
+    /** \brief Adds a board
+     *
+     * \param board The board
+     * \param length The optimal solution length, or Corpus::UNKNOWN_LENGTH; ignored unless lengths are written
+     * \throw std::ios_base::failure From std::ofstream; if a file operation goes wrong
+     */
+    void CorpusWriter::add(const PackedGrid &board, const std::uint8_t length)
+    {
+        if (!fileStream.is_open())
+            throw std::ios_base::failure {"Corpus already closed"};
+
+        buffer.push_back(board.getTiles());
+        ++count;
+
+        if (withLengths)
+            lengths.push_back(length);
+
+        if (buffer.size() == BUFFER_RECORDS)
+            flush();
+    }
+
+    /** \brief Writes the rest of the records, the lengths, and the header, then closes the file
+     *
+     * Does nothing if the file is already closed
+     *
+     * \throw std::ios_base::failure From std::ofstream; if a file operation goes wrong
+     */
+    void CorpusWriter::close()
+    {
+        if (!fileStream.is_open())
+            return;
+
+        flush();
+
+        if (withLengths)
+        {
+            fileStream.write(reinterpret_cast<const char *> (lengths.data()), lengths.size());
+            checksum = {MappedFile::checksum(lengths.data(), lengths.size(), checksum)};
+        }
+
+        FileHeader header {};
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = {Corpus::FILE_VERSION};
+        header.byteOrder = {BYTE_ORDER_MARK};
+        header.count = {count};
+        header.flags = {withLengths ? HAS_LENGTHS : 0};
+        header.checksum = {checksum};
+
+        fileStream.seekp(0);
+        fileStream.write(reinterpret_cast<const char *> (&header), sizeof(FileHeader));
+        fileStream.close();
+    }
+
+    ///Writes the buffered records and adds them to the checksum
+    void CorpusWriter::flush()
+    {
+        const std::size_t bytes {buffer.size() * sizeof(Corpus::record_t)};
+
+        fileStream.write(reinterpret_cast<const char *> (buffer.data()), bytes);
+        checksum = {MappedFile::checksum(reinterpret_cast<const std::uint8_t *> (buffer.data()), bytes, checksum)};
+
+        buffer.clear();
+    }
+}
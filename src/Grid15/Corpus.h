@@ -0,0 +1,130 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef CORPUS_H
+#define CORPUS_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/PackedGrid.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+
+
+namespace Grid15
+{
+    /** \class Corpus
+     *
+     * \brief A read only, memory mapped file of many boards, made with CorpusWriter
+     *
+     * The file is a header, then one 8 byte record per board (the tiles of a PackedGrid), then optionally one byte per board with
+     * its optimal solution length. Opening maps the file instead of reading it, so records are used straight from the page cache
+     * with nothing to parse: Corpus::begin and Corpus::end iterate them in place.
+     * Numbers are stored in the byte order of the computer that saved the file.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class Corpus
+    {
+        public:
+            /* Typedefs */
+            typedef PackedGrid::tiles_t record_t;///<The type of a record; see PackedGrid::getTiles
+
+
+            /* Setup */
+            explicit Corpus(const std::string &file);
+
+
+            /* Access */
+            ///Gets how many boards there are
+            std::size_t size() const {return count;}
+            ///Checks if the file has the optimal length of each board
+            bool hasLengths() const {return lengths != nullptr;}
+
+            ///Gets the first record, straight from the mapped file
+            const record_t *begin() const {return records;}
+            ///Gets the end of the records
+            const record_t *end() const {return records + count;}
+
+            PackedGrid at(const std::size_t record) const;
+            std::uint8_t length(const std::size_t record) const;
+
+            bool verify() const;
+
+
+            static constexpr std::uint32_t FILE_VERSION {1};        ///<The version of the corpus file format written by CorpusWriter
+            static constexpr std::uint8_t UNKNOWN_LENGTH {0xFF};    ///<The length of a board whose optimal length is not known
+
+        private:
+            std::shared_ptr<const void> storage {};     ///<The memory mapped file
+            const record_t *records {nullptr};          ///<The records
+            const std::uint8_t *lengths {nullptr};      ///<The optimal lengths, or nullptr if there are none
+            std::size_t count {0};                      ///<How many records there are
+            std::uint64_t checksum {0};                 ///<The checksum of the records and lengths from the header
+    };
+
+    /** \class CorpusWriter
+     *
+     * \brief Writes boards to a Corpus file, one at a time
+     *
+     * The header is filled in by CorpusWriter::close, or by the destructor if close was never called.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class CorpusWriter
+    {
+        public:
+            /* Setup */
+            CorpusWriter(const std::string &file, const bool newWithLengths = false);
+            ~CorpusWriter();
+
+            CorpusWriter(const CorpusWriter &other) = delete;
+            CorpusWriter &operator=(const CorpusWriter &other) = delete;
+
+
+            /* Writing */
+            void add(const Grid &grid, const std::uint8_t length = Corpus::UNKNOWN_LENGTH);
+            void add(const PackedGrid &board, const std::uint8_t length = Corpus::UNKNOWN_LENGTH);
+            void close();
+
+            ///Gets how many boards have been added
+            std::size_t size() const {return count;}
+
+        private:
+            void flush();
+
+            std::ofstream fileStream {};                    ///<The file
+            bool withLengths {false};                       ///<If the optimal lengths are written too
+            std::vector<Corpus::record_t> buffer {};        ///<Records not written yet
+            std::vector<std::uint8_t> lengths {};           ///<Every length so far; written after the records
+            std::size_t count {0};                          ///<How many boards have been added
+            std::uint64_t checksum {0};                     ///<The checksum of the records written so far
+    };
+}
+#endif //CORPUS_H
@@ -0,0 +1,244 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/Generator.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/Solver.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <random>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    namespace Generator
+    {
+        namespace
+        {
+            constexpr std::uint8_t LONGEST              {80};   ///<No board needs more moves than this
+            constexpr std::uint8_t HARD_MIN             {46};   ///<The shortest hard board; almost all uniformly random boards are longer
+            constexpr std::uint_fast32_t LONGEST_WALK   {400};  ///<Walks this long are no better than uniformly random boards, which are faster to make
+            constexpr std::size_t ATTEMPTS_PER_PUZZLE   {1000}; ///<How many candidates are tried for each puzzle asked for when no limit is given
+
+            /** \brief Generates puzzles with any heuristic on a pool of threads
+             *
+             * Each candidate aims at a random length in the range, so the puzzles are spread over the whole range instead of bunching up at
+             * one end. Each thread keeps a walk length for each length it aims at: it gets longer after a candidate that was too short and
+             * shorter after one that was too long, so it settles where walks land on that length.
+             * A board that was already found is not used again.
+             *
+             * \param count How many puzzles to make
+             * \param range The optimal lengths allowed
+             * \param lowerBound Gives a lower bound on the optimal length of a Grid
+             * \param solve Solves a Grid with Solver::solve
+             * \param threads The number of threads to use; 0 means one per hardware thread
+             * \param maxAttempts How many candidates to try in all before giving up; 0 means ATTEMPTS_PER_PUZZLE for each puzzle
+             * \return The puzzles, in the order they were found; fewer than count if the attempts ran out
+             * \throw std::invalid_argument If the range is invalid
+             * \throw Anything solve throws, once every thread has stopped
+             */
+            template <typename LowerBound, typename Solve>
+            std::vector<Puzzle> generateWith(const std::size_t count, const Range range, const LowerBound &lowerBound, const Solve &solve, std::size_t threads,
+                                             std::size_t maxAttempts)
+            {
+                if (range.min > range.max || range.max > LONGEST)
+                    throw std::invalid_argument {"Range invalid!"};
+
+                if (threads == 0)
+                    threads = {std::max<std::size_t> (std::thread::hardware_concurrency(), 1)};
+
+                if (maxAttempts == 0)
+                    maxAttempts = {count * ATTEMPTS_PER_PUZZLE};
+
+                std::vector<Puzzle> puzzles {};
+                puzzles.reserve(count);
+
+                std::mutex puzzlesMutex {};
+                std::unordered_set<std::uint64_t> found {};//the Grid::hash of each puzzle, so walks that land on the same board do not add it twice
+                std::exception_ptr error {};//the first exception a thread caught, to rethrow on this one
+                std::atomic<bool> done {count == 0};
+                std::atomic<std::size_t> attempts {0};
+
+                auto work = [&]()
+                {
+                    std::random_device device {};
+                    std::seed_seq seed {device(), device(), device(), device()};
+                    std::mt19937_64 engine {seed};
+
+                    std::uniform_int_distribution<std::uint_fast32_t> targets {range.min, range.max};
+                    std::vector<std::uint_fast32_t> walkLengths(LONGEST + 1);
+
+                    for (std::uint_fast32_t target {0}; target <= LONGEST; ++target)
+                        walkLengths[target] = {target};
+
+                    while (!done)
+                    {
+                        if (attempts++ >= maxAttempts)
+                        {
+                            done = {true};
+                            break;
+                        }
+
+                        const std::uint_fast32_t target {targets(engine)};
+                        std::uint_fast32_t &walkLength {walkLengths[target]};
+
+                        const Grid grid {walkLength >= LONGEST_WALK ? GridHelp::generateRandomGrid() : GridHelp::scrambleGrid(walkLength, engine())};
+                        std::uint_fast32_t length {LONGEST + 1};
+
+                        if (lowerBound(grid) <= range.max)//otherwise it is already too long, so do not bother solving it
+                        {
+                            try
+                            {
+                                length = {solve(grid).moves.size()};
+                            }
+                            catch (...)//an exception leaving the thread would end the program
+                            {
+                                std::lock_guard<std::mutex> lock {puzzlesMutex};
+
+                                if (!error)
+                                    error = {std::current_exception()};
+
+                                done = {true};
+                                break;
+                            }
+                        }
+
+                        if (length < target)
+                            walkLength = {std::min(walkLength + 1, LONGEST_WALK)};
+                        else if (length > target && walkLength > 0)
+                            --walkLength;
+
+                        if (length >= range.min && length <= range.max)
+                        {
+                            std::lock_guard<std::mutex> lock {puzzlesMutex};
+
+                            if (puzzles.size() < count && found.insert(grid.hash).second)
+                                puzzles.push_back({grid, static_cast<std::uint8_t> (length)});
+
+                            if (puzzles.size() >= count)
+                                done = {true};
+                        }
+                    }
+                };
+
+                std::vector<std::thread> workers {};
+
+                for (std::size_t i {0}; i < threads; ++i)
+                    workers.emplace_back(work);
+
+                for (std::thread &worker : workers)
+                    worker.join();
+
+                if (error)
+                    std::rethrow_exception(error);
+
+                return puzzles;
+            }
+        }
+
+        /** \brief Gets the range of optimal lengths used for a difficulty
+         *
+         * \param difficulty The difficulty
+         * \return Easy is 10 to 30 moves, medium is 31 to 45 and hard is 46 or more
+         */
+        Range difficultyRange(const Difficulty difficulty)
+        {
+            switch (difficulty)
+            {
+                case Difficulty::EASY:
+                    return {10, 30};
+                case Difficulty::MEDIUM:
+                    return {31, 45};
+                default:
+                    return {HARD_MIN, LONGEST};
+            }
+        }
+
+        /** \brief Makes puzzles using the Manhattan distance and linear conflict heuristic; fine for easy and medium ranges
+         *
+         * \param count How many puzzles to make
+         * \param range The optimal lengths allowed
+         * \param threads The number of threads to use; 0 means one per hardware thread
+         * \param maxAttempts How many candidates to try in all before giving up; 0 means 1000 for each puzzle
+         * \return The puzzles, in the order they were found; fewer than count if the attempts ran out
+         * \throw std::invalid_argument If the range is invalid
+         */
+        std::vector<Puzzle> generate(const std::size_t count, const Range range, const std::size_t threads, const std::size_t maxAttempts)
+        {
+            auto lowerBound = [](const Grid &grid) {return Solver::manhattanDistance(grid) + Solver::linearConflict(grid);};
+            auto solve = [](const Grid &grid) {return Solver::solve(grid);};
+
+            return generateWith(count, range, lowerBound, solve, threads, maxAttempts);
+        }
+
+        /** \brief Makes puzzles using pattern databases; much faster on hard ranges
+         *
+         * \param count How many puzzles to make
+         * \param range The optimal lengths allowed
+         * \param database The pattern databases to use
+         * \param threads The number of threads to use; 0 means one per hardware thread
+         * \param maxAttempts How many candidates to try in all before giving up; 0 means 1000 for each puzzle
+         * \return The puzzles, in the order they were found; fewer than count if the attempts ran out
+         * \throw std::invalid_argument If the range is invalid, or the database is corrupted (see PatternDatabase::verify)
+         */
+        std::vector<Puzzle> generate(const std::size_t count, const Range range, const PatternDatabase &database, const std::size_t threads, const std::size_t maxAttempts)
+        {
+            auto lowerBound = [&database](const Grid &grid) {return database.estimate(grid);};
+            auto solve = [&database](const Grid &grid) {return Solver::solve(grid, database);};
+
+            return generateWith(count, range, lowerBound, solve, threads, maxAttempts);
+        }
+
+        /** \brief Makes puzzles using walking distance tables
+         *
+         * \param count How many puzzles to make
+         * \param range The optimal lengths allowed
+         * \param tables The walking distance tables to use
+         * \param threads The number of threads to use; 0 means one per hardware thread
+         * \param maxAttempts How many candidates to try in all before giving up; 0 means 1000 for each puzzle
+         * \return The puzzles, in the order they were found; fewer than count if the attempts ran out
+         * \throw std::invalid_argument If the range is invalid
+         */
+        std::vector<Puzzle> generate(const std::size_t count, const Range range, const WalkingDistance &tables, const std::size_t threads, const std::size_t maxAttempts)
+        {
+            auto lowerBound = [&tables](const Grid &grid) {return tables.estimate(grid);};
+            auto solve = [&tables](const Grid &grid) {return Solver::solve(grid, tables);};
+
+            return generateWith(count, range, lowerBound, solve, threads, maxAttempts);
+        }
+    }
+}
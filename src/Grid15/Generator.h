@@ -0,0 +1,81 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace Grid15
+{
+    /** \brief Makes random boards whose optimal solution length is in a given range
+     *
+     * Uniformly random boards almost all need 50 to 60 moves, so easier boards are made by random walks from Grid::GOAL_GRID instead.
+     * Each candidate is first checked against a lower bound (the heuristic), and only solved exactly with Solver::solve if it could
+     * still be short enough. Candidates are made and checked on several threads at once, and each board is only given once.
+     * Generation gives up after a limited number of candidates, so a range that walks almost never land in still finishes.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    namespace Generator
+    {
+        /** \brief A range of optimal solution lengths, both ends included
+         *
+         * \author John Jekel
+         * \date 2018-2018
+         */
+        struct Range
+        {
+            std::uint8_t min {0};   ///<The shortest optimal length allowed
+            std::uint8_t max {80};  ///<The longest optimal length allowed; no board needs more than 80 moves
+        };
+
+        enum class Difficulty {EASY, MEDIUM, HARD};
+
+        /** \brief A generated board
+         *
+         * \author John Jekel
+         * \date 2018-2018
+         */
+        struct Puzzle
+        {
+            Grid grid {};               ///<The board
+            std::uint8_t length {0};    ///<The length of its optimal solution
+        };
+
+        Range difficultyRange(const Difficulty difficulty);
+
+        std::vector<Puzzle> generate(const std::size_t count, const Range range, const std::size_t threads = 0, const std::size_t maxAttempts = 0);
+        std::vector<Puzzle> generate(const std::size_t count, const Range range, const PatternDatabase &database, const std::size_t threads = 0, const std::size_t maxAttempts = 0);
+        std::vector<Puzzle> generate(const std::size_t count, const Range range, const WalkingDistance &tables, const std::size_t threads = 0, const std::size_t maxAttempts = 0);
+    }
+}
+#endif //GENERATOR_H
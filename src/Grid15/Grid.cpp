@@ -31,6 +31,39 @@
 
 namespace Grid15
 {
+    namespace
+    {
+        typedef std::array<std::array<std::uint64_t, Grid::CELLS>, Grid::CELLS> zobristKeys_t;///<A random key for each tile on each cell
+
+        /** \brief Makes the keys for Zobrist hashing with the splitmix64 generator, so they are the same every time
+         *
+         * \return The keys, by [tile][(y * Grid::COLUMS) + x]
+         */
+        constexpr zobristKeys_t makeZobristKeys()
+        {
+            zobristKeys_t keys {};
+            std::uint64_t state {0x15111D15111D1500};
+
+            for (std::size_t tile {0}; tile < Grid::CELLS; ++tile)
+            {
+                for (std::size_t cell {0}; cell < Grid::CELLS; ++cell)
+                {
+                    state += 0x9E3779B97F4A7C15;
+
+                    std::uint64_t key {state};
+                    key = {(key ^ (key >> 30)) * 0xBF58476D1CE4E5B9};
+                    key = {(key ^ (key >> 27)) * 0x94D049BB133111EB};
+
+                    keys[tile][cell] = {key ^ (key >> 31)};
+                }
+            }
+
+            return keys;
+        }
+
+        constexpr zobristKeys_t ZOBRIST_KEYS {makeZobristKeys()};///<The keys used by Grid::zobristKey
+    }
+
     /* Grid Setup */
 ///Creates a new Grid, leaving everything uninitialized
     Grid::Grid() {}
@@ -43,6 +76,8 @@ namespace Grid15
     {
         //setGridArray(newGrid);
         std::copy(std::begin(newGrid), std::end(newGrid), std::begin(gridArray));
+        hash = {hashGridArray(gridArray)};
+        metrics = {measureGridArray(gridArray)};
     }
 
     /** \brief Creates a new Grid and copies an index to it
@@ -63,6 +98,8 @@ namespace Grid15
     {
         std::copy(std::begin(newGrid), std::end(newGrid), std::begin(gridArray));
         std::copy(std::begin(newIndex), std::end(newIndex), std::begin(index));
+        hash = {hashGridArray(gridArray)};
+        metrics = {measureGridArray(gridArray)};
     }
 
     /** \brief Creates and copies a new Grid
@@ -73,6 +110,8 @@ namespace Grid15
     {
         std::copy(std::begin(newGrid.gridArray), std::end(newGrid.gridArray), std::begin(gridArray));
         std::copy(std::begin(newGrid.index), std::end(newGrid.index), std::begin(index));
+        hash = {newGrid.hash};
+        metrics = {newGrid.metrics};
     }
 
     /** \brief Copies a Grid
@@ -86,6 +125,8 @@ namespace Grid15
 
         std::copy(std::begin(newGrid.gridArray), std::end(newGrid.gridArray), std::begin(gridArray));
         std::copy(std::begin(newGrid.index), std::end(newGrid.index), std::begin(index));
+        hash = {newGrid.hash};
+        metrics = {newGrid.metrics};
 
         return *this;
     }
@@ -97,6 +138,8 @@ namespace Grid15
     void Grid::setGridArray(const gridArray_t &newGrid)
     {
         std::copy(std::begin(newGrid), std::end(newGrid), std::begin(gridArray));
+        hash = {hashGridArray(gridArray)};
+        metrics = {measureGridArray(gridArray)};
     }
 
     /** \brief Sets Grid::index
@@ -116,5 +159,132 @@ namespace Grid15
     {
         std::copy(std::begin(newGrid.gridArray), std::end(newGrid.gridArray), std::begin(gridArray));
         std::copy(std::begin(newGrid.index), std::end(newGrid.index), std::begin(index));
+        hash = {newGrid.hash};
+        metrics = {newGrid.metrics};
+    }
+
+    /* Comparison */
+    /** \brief Checks if two Grids have the same tiles in the same places
+     *
+     * Only the grid arrays are compared; the index and hash follow from them
+     *
+     * \param other The Grid to compare to
+     * \return If the grid arrays are equal
+     */
+    bool Grid::operator==(const Grid &other) const
+    {
+        return gridArray == other.gridArray;
+    }
+
+    /** \brief Checks if two Grids differ
+     *
+     * \param other The Grid to compare to
+     * \return If the grid arrays are not equal
+     */
+    bool Grid::operator!=(const Grid &other) const
+    {
+        return gridArray != other.gridArray;
+    }
+
+    /* Hashing */
+    /** \brief Finds the Zobrist hash of a grid array from scratch
+     *
+     * \param gridArray The grid array to hash
+     * \return The xor of the key of every tile on its cell
+     */
+    std::uint64_t Grid::hashGridArray(const gridArray_t &gridArray)
+    {
+        std::uint64_t newHash {0};
+
+        for (std::uint_fast32_t i {0}; i < ROWS; ++i)
+            for (std::uint_fast32_t j {0}; j < COLUMS; ++j)
+                newHash ^= ZOBRIST_KEYS[gridArray[i][j] % CELLS][(i * COLUMS) + j];//the modulo keeps invalid grid arrays in range
+
+        return newHash;
+    }
+
+    /** \brief Gets the Zobrist key of a tile on a cell
+     *
+     * Moving a tile from one cell to another changes the hash by the xor of both of its keys
+     *
+     * \param tile The tile
+     * \param tileY The y coordinate
+     * \param tileX The x coordinate
+     * \return The key
+     */
+    std::uint64_t Grid::zobristKey(const std::uint8_t tile, const std::uint8_t tileY, const std::uint8_t tileX)
+    {
+        return ZOBRIST_KEYS[tile % CELLS][((tileY * COLUMS) + tileX) % CELLS];
+    }
+
+    /* Metrics */
+    /** \brief Finds the running values of a grid array from scratch
+     *
+     * \param gridArray The grid array to measure
+     * \return The metrics
+     */
+    Grid::Metrics Grid::measureGridArray(const gridArray_t &gridArray)
+    {
+        Metrics newMetrics {};
+        std::array<std::uint8_t, CELLS> tiles {};
+        std::size_t tileCount {0};
+        std::array<bool, CELLS> seenTiles {};
+        bool repeatedTile {false};
+
+        for (std::uint_fast32_t i {0}; i < ROWS; ++i)
+        {
+            for (std::uint_fast32_t j {0}; j < COLUMS; ++j)
+            {
+                const std::uint8_t tile {static_cast<std::uint8_t> (gridArray[i][j] % CELLS)};//the modulo keeps invalid grid arrays in range
+
+                if (tile != NO_TILE)
+                {
+                    newMetrics.manhattanDistance += goalDistance(tile, static_cast<std::uint8_t> (i), static_cast<std::uint8_t> (j));
+                    newMetrics.misplacedTiles += (goalDistance(tile, static_cast<std::uint8_t> (i), static_cast<std::uint8_t> (j)) != 0) ? 1 : 0;
+
+                    tiles[tileCount++] = {tile};
+                    repeatedTile = {repeatedTile || seenTiles[tile]};
+                    seenTiles[tile] = {true};
+                }
+            }
+        }
+
+        //the parity of the inversions is the parity of the tiles as a permutation, which is (tiles - cycles) % 2, so O(n) instead of
+        //comparing every pair; tiles are 1 to TILE_MAX, so tile - 1 is where it belongs in the sequence
+        //an invalid grid array (a missing or repeated tile) is not a permutation and the walk would leave the sequence, so it has no parity
+        if (tileCount != TILE_MAX || repeatedTile)
+            return newMetrics;
+
+        std::array<bool, CELLS> visited {};
+        std::size_t cycles {0};
+
+        for (std::size_t i {0}; i < tileCount; ++i)
+        {
+            if (!visited[i])
+            {
+                ++cycles;
+
+                for (std::size_t j {i}; !visited[j]; j = {static_cast<std::size_t> (tiles[j] - 1)})
+                    visited[j] = {true};
+            }
+        }
+
+        newMetrics.oddInversions = {((tileCount - cycles) % 2) != 0};
+
+        newMetrics.won = {gridArray == GOAL_GRID};
+
+        return newMetrics;
+    }
+
+    /** \brief Gets how far a tile on a cell is from where it is in Grid::GOAL_GRID
+     *
+     * \param tile The tile
+     * \param tileY The y coordinate
+     * \param tileX The x coordinate
+     * \return The Manhattan distance; 0 for the no tile
+     */
+    std::uint8_t Grid::goalDistance(const std::uint8_t tile, const std::uint8_t tileY, const std::uint8_t tileX)
+    {
+        return basicGrid_t::GOAL_DISTANCES[tile % CELLS][((tileY * COLUMS) + tileX) % CELLS];
     }
 }
@@ -24,8 +24,11 @@
 #define GRID_H
 
 
+#include "Grid15/BasicGrid.h"
+
 #include <cstdint>
 #include <array>
+#include <functional>
 
 
 namespace Grid15
@@ -41,9 +44,24 @@ namespace Grid15
     {
         public:
             /* Typedefs */
+            typedef BasicGrid<4, 4> basicGrid_t;///<The generic board of the same size, whose compile time tables Grid uses
+
             //TODO change to std::uint_fast32_t for speed
-            typedef std::array<std::array<std::uint8_t, 4>, 4>  gridArray_t;///<The type used for Grid::gridArray
-            typedef std::array<std::array<std::uint8_t, 2>, 16> index_t;///<The type used for Grid::index
+            typedef basicGrid_t::gridArray_t gridArray_t;///<The type used for Grid::gridArray
+            typedef basicGrid_t::index_t index_t;///<The type used for Grid::index
+
+            /** \brief Running values about the grid array, kept up to date like Grid::hash so they never need a rescan
+             *
+             * \author John Jekel
+             * \date 2018-2018
+             */
+            struct Metrics
+            {
+                std::uint8_t manhattanDistance {0}; ///<The sum of how far each tile (not the no tile) is from where it is in Grid::GOAL_GRID
+                std::uint8_t misplacedTiles {0};    ///<How many tiles (not the no tile) are not where they are in Grid::GOAL_GRID
+                bool oddInversions {false};         ///<If the tiles, read left to right and top to bottom without the no tile, have an odd number of pairs out of order
+                bool won {false};                   ///<If the grid array is equal to Grid::GOAL_GRID
+            };
 
 
             /* Grid Setup */
@@ -59,6 +77,15 @@ namespace Grid15
 
             void setIndex(const index_t &newIndex);
 
+            bool operator==(const Grid &other) const;
+            bool operator!=(const Grid &other) const;
+
+            static std::uint64_t hashGridArray(const gridArray_t &gridArray);
+            static std::uint64_t zobristKey(const std::uint8_t tile, const std::uint8_t tileY, const std::uint8_t tileX);
+
+            static Metrics measureGridArray(const gridArray_t &gridArray);
+            static std::uint8_t goalDistance(const std::uint8_t tile, const std::uint8_t tileY, const std::uint8_t tileX);
+
             /* Storage */
             //the grid, with [y] and [x] indexes from top left to bottom right
             //0 is no tile, 1 to 15 are the other tiles
@@ -71,25 +98,41 @@ namespace Grid15
             //FIXME [tile][0] is y, [tile][1] is x, again these should be flipped
             index_t index {};///<The index to keep track of tile locations
 
+            //Zobrist hash of the grid array: the xor of Grid::zobristKey for every tile
+            //set by the grid array constructors, Grid::setGridArray and GridHelp::reIndex, and updated by GridHelp::swapTile
+            //if the grid array is changed directly, GridHelp::reIndex must be called before the hash is used again
+            std::uint64_t hash {0};///<The hash of the grid array, for use with std::hash
+
+            //kept up to date the same way as the hash; GridHelp::swapTile changes each value in O(1)
+            Metrics metrics {};///<Running values about the grid array
+
             //TODO change "no tile" to "blank tile" or just "blank"
-            static constexpr std::size_t NO_TILE   {0};    ///<The number representing the lack of a tile
-            static constexpr std::size_t TILE_MAX  {15};   ///<The maximum tile number
-            static constexpr std::size_t TILE_MIN  {0};    ///<The mininum tile number
-            static constexpr std::size_t Y_MAX     {3};    ///<The maximum y coordinate
-            static constexpr std::size_t Y_MIN     {0};    ///<The mininum x coordinate
-            static constexpr std::size_t X_MAX     {3};    ///<The maximum x coordinate
-            static constexpr std::size_t X_MIN     {0};    ///<The mininum x coordinate
+            static constexpr std::size_t NO_TILE   {basicGrid_t::layout_t::NO_TILE};   ///<The number representing the lack of a tile
+            static constexpr std::size_t TILE_MAX  {basicGrid_t::layout_t::TILE_MAX};  ///<The maximum tile number
+            static constexpr std::size_t TILE_MIN  {0};                                ///<The mininum tile number
+            static constexpr std::size_t Y_MAX     {basicGrid_t::layout_t::Y_MAX};     ///<The maximum y coordinate
+            static constexpr std::size_t Y_MIN     {0};                                ///<The mininum x coordinate
+            static constexpr std::size_t X_MAX     {basicGrid_t::layout_t::X_MAX};     ///<The maximum x coordinate
+            static constexpr std::size_t X_MIN     {0};                                ///<The mininum x coordinate
+            static constexpr std::size_t ROWS      {basicGrid_t::layout_t::ROWS};      ///<The number of rows
+            static constexpr std::size_t COLUMS    {basicGrid_t::layout_t::COLUMS};    ///<The number of colums
+            static constexpr std::size_t CELLS     {basicGrid_t::layout_t::CELLS};     ///<The number of cells (and tiles, counting the no tile)
 
             ///How the gridArray should be when the game is won
-            static constexpr gridArray_t GOAL_GRID
-            {
-                {
-                    {1,  2,  3,  4,},
-                    {5,  6,  7,  8,},
-                    {9,  10, 11, 12,},
-                    {13, 14, 15, Grid::NO_TILE}
-                }
-            };
+            static constexpr gridArray_t GOAL_GRID {basicGrid_t::GOAL_GRID};
+    };
+}
+
+namespace std
+{
+    ///Lets a Grid be the key of std::unordered_map and the like, using Grid::hash
+    template <>
+    struct hash<Grid15::Grid>
+    {
+        std::size_t operator()(const Grid15::Grid &grid) const noexcept
+        {
+            return static_cast<std::size_t> (grid.hash);
+        }
     };
 }
 #endif //GRID_H
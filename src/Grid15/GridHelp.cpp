@@ -24,15 +24,21 @@
 
 #include "Grid15/GridHelp.h"
 
+#include "Grid15/Solver.h"
+
 #include <cstdint>
+#include <cstddef>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <array>
+#include <vector>
 #include <algorithm>
+#include <unordered_set>
 #include <random>
-#include <chrono>
 #include <exception>
+#include <charconv>
+#include <system_error>
 
 
 namespace Grid15
@@ -61,31 +67,54 @@ namespace Grid15
          * \throw std::invalid_argument The tile being moved is invalid, not next to the no tile or the Grid is invalid
          */
         void swapTile(const std::uint8_t tileNum, Grid &grid)
+        {
+            if (validMove(tileNum, grid))
+                swapTileUnchecked(tileNum, grid);
+            else
+                throw std::invalid_argument {"tileNum or Grid invalid!"};//not a valid move
+        }
+
+        /** \brief Swaps the tile given with the no tile of a Grid, trusting that the move is valid
+         *
+         * Nothing is checked, so this is only a few loads and stores; use validMoveUnchecked first if the move might not be valid (see also ValidatedGrid)
+         *
+         * \param tileNum The tile to swap; must be next to the no tile
+         * \param grid The Grid to change; must be valid
+         */
+        void swapTileUnchecked(const std::uint8_t tileNum, Grid &grid) noexcept
         {
             //original location of tile
             const std::uint8_t tileY {grid.index[tileNum][0]};
             const std::uint8_t tileX {grid.index[tileNum][1]};
 
-            if (validMove(tileY, tileX, grid))
-            {
-                //original location of blank tile
-                std::uint8_t oldNoTileY = {grid.index[Grid::NO_TILE][0]};
-                std::uint8_t oldNoTileX = {grid.index[Grid::NO_TILE][1]};
+            //original location of blank tile
+            std::uint8_t oldNoTileY = {grid.index[Grid::NO_TILE][0]};
+            std::uint8_t oldNoTileX = {grid.index[Grid::NO_TILE][1]};
 
-                grid.gridArray[grid.index[Grid::NO_TILE][0]][grid.index[Grid::NO_TILE][1]] = {tileNum};//moves tile
+            grid.gridArray[oldNoTileY][oldNoTileX] = {tileNum};//moves tile
 
-                //updates location of moved tile in index
-                grid.index[tileNum][0] = {oldNoTileY};
-                grid.index[tileNum][1] = {oldNoTileX};
+            //updates location of moved tile in index
+            grid.index[tileNum][0] = {oldNoTileY};
+            grid.index[tileNum][1] = {oldNoTileX};
 
-                grid.gridArray[tileY][tileX] = {Grid::NO_TILE};//moves noTile
+            grid.gridArray[tileY][tileX] = {Grid::NO_TILE};//moves noTile
 
-                //updates location of noTile in index
-                grid.index[Grid::NO_TILE][0] = {tileY};
-                grid.index[Grid::NO_TILE][1] = {tileX};
-            }
-            else
-                throw std::invalid_argument {"tileNum or Grid invalid!"};//not a valid move
+            //updates location of noTile in index
+            grid.index[Grid::NO_TILE][0] = {tileY};
+            grid.index[Grid::NO_TILE][1] = {tileX};
+
+            //the tile and the no tile trade cells, so both keys change
+            grid.hash ^= Grid::zobristKey(tileNum, tileY, tileX) ^ Grid::zobristKey(tileNum, oldNoTileY, oldNoTileX);
+            grid.hash ^= Grid::zobristKey(Grid::NO_TILE, tileY, tileX) ^ Grid::zobristKey(Grid::NO_TILE, oldNoTileY, oldNoTileX);
+
+            //only the moved tile's distance changes, and a move up or down jumps the tile over 3 others, which flips the inversion parity
+            const std::uint8_t oldDistance {Grid::goalDistance(tileNum, tileY, tileX)};
+            const std::uint8_t newDistance {Grid::goalDistance(tileNum, oldNoTileY, oldNoTileX)};
+
+            grid.metrics.manhattanDistance = static_cast<std::uint8_t> (grid.metrics.manhattanDistance + newDistance - oldDistance);
+            grid.metrics.misplacedTiles = static_cast<std::uint8_t> (grid.metrics.misplacedTiles + (newDistance != 0) - (oldDistance != 0));
+            grid.metrics.oddInversions = {grid.metrics.oddInversions != (tileY != oldNoTileY)};
+            grid.metrics.won = {grid.metrics.misplacedTiles == 0};
         }
 
         /** \brief Checks if the tile movement will be valid between a tile and the no tile of a Grid
@@ -130,7 +159,30 @@ namespace Grid15
                 throw std::invalid_argument {"Grid invalid!"};
         }
 
+        /** \brief Checks if the tile movement will be valid between a tile and the no tile of a Grid, trusting that the Grid is valid
+         *
+         * Only the index is read, so this is a few comparisons instead of the full check in validMove
+         *
+         * \param tileNum The tile to check
+         * \param grid The Grid to use; must be valid
+         * \return If swapping the tile would work (true) or not (false)
+         */
+        bool validMoveUnchecked(const std::uint8_t tileNum, const Grid &grid) noexcept
+        {
+            if ((tileNum > Grid::TILE_MAX) || (tileNum == Grid::NO_TILE))
+                return false;
+
+            //the tile and the no tile must be exactly one row or one colum apart
+            const std::int_fast32_t yDistance {grid.index[tileNum][0] - grid.index[Grid::NO_TILE][0]};
+            const std::int_fast32_t xDistance {grid.index[tileNum][1] - grid.index[Grid::NO_TILE][1]};
+
+            return ((yDistance * yDistance) + (xDistance * xDistance)) == 1;
+        }
+
         /** \brief Checks if a Grid is won
+         *
+         * Compares the grid array itself, so it is right even after Grid::gridArray is written directly; use hasWonUnchecked
+         * (or ValidatedGrid) to just read Grid::Metrics::won
          *
          * \param grid The Grid to use
          * \return If Grid::grid is equal to Grid::GOAL_GRID
@@ -144,6 +196,18 @@ namespace Grid15
                 throw std::invalid_argument {"Grid invalid!"};
         }
 
+        /** \brief Checks if a Grid is won, trusting that the Grid is valid
+         *
+         * Just reads Grid::Metrics::won, so it does not see writes made to Grid::gridArray directly (see hasWon)
+         *
+         * \param grid The Grid to use; must be valid
+         * \return If Grid::grid is equal to Grid::GOAL_GRID
+         */
+        bool hasWonUnchecked(const Grid &grid) noexcept
+        {
+            return grid.metrics.won;
+        }
+
         /** \brief Checks if a grid array is valid
          *
          * \param grid The grid array to check
@@ -151,21 +215,21 @@ namespace Grid15
          */
         bool validGridArray(const Grid::gridArray_t &grid)
         {
-            std::array<std::uint8_t, 16> numCount {0};//start at 0//FIXME SET ALL TO 0 (MAYBE NEEDED)
+            std::array<std::uint8_t, Grid::CELLS> numCount {0};//start at 0//FIXME SET ALL TO 0 (MAYBE NEEDED)
 
-            for (std::uint_fast32_t i {0}; i < 4; ++i)
-                for (std::uint_fast32_t j {0}; j < 4; ++j)
+            for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
+                for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
                 {
                     if (grid[i][j] > Grid::TILE_MAX)
                         return false;//if too high a number (out of bounds)
                 }
 
 
-            for (std::uint_fast32_t i {0}; i < 4; ++i)
-                for (std::uint_fast32_t j {0}; j < 4; ++j)
+            for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
+                for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
                     numCount[grid[i][j]] += 1;//increment each number to see how many of each
 
-            for (std::uint_fast32_t i {0}; i < 16; ++i)
+            for (std::uint_fast32_t i {0}; i < Grid::CELLS; ++i)
             {
                 if (!(numCount[i] == 1))
                     return false;//if exactly 1 of each number
@@ -183,10 +247,16 @@ namespace Grid15
          */
         bool validIndex(const Grid::gridArray_t &grid, const Grid::index_t &index)
         {
-            Grid tempGrid {grid};
-            reIndex(tempGrid);//we can rely on this to throw std::invalid_argument
+            if (!validGridArray(grid))
+                throw std::invalid_argument {"Grid invalid!"};
 
-            return std::equal(std::begin(tempGrid.index), std::end(tempGrid.index), std::begin(index));
+            //every tile is on exactly one cell, so the index is right if it points each tile at its own cell
+            for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
+                for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
+                    if ((index[grid[i][j]][0] != i) || (index[grid[i][j]][1] != j))
+                        return false;
+
+            return true;
         }
 
         /** \brief Copies a Grid. Better than Grid::setGrid because it ensures validation and also creates a new index
@@ -199,7 +269,7 @@ namespace Grid15
         {
             if (validGridArray(newGrid))//fixme rely on validGridArray in index only
             {
-                grid.setGridArray(newGrid);
+                grid.gridArray = {newGrid};//not Grid::setGridArray; reIndex below recalculates the hash and metrics anyway
 
                 reIndex(grid);//also checks validGridArray; unavoidable for now but inefficient
             }
@@ -208,6 +278,9 @@ namespace Grid15
         }
 
         /** \brief Copies a Grid. Better than Grid::setGrid because it ensures validation of the grid array and the index
+         *
+         * The hash and metrics are worked out again rather than copied, since nothing checks them and they may be stale
+         * (if the grid array was changed directly, or the Grid was made from only an index)
          *
          * \param newGrid The new grid to
          * \param grid The Grid to copy to
@@ -215,10 +288,14 @@ namespace Grid15
          */
         void safeCopy(const Grid &newGrid, Grid &grid)
         {
-            if (validGrid(newGrid))
-                grid.setGrid(newGrid);
-            else
+            Grid checked {};
+            checked.gridArray = {newGrid.gridArray};
+            reIndex(checked);//throws std::invalid_argument if the grid array is invalid; also works out the hash and metrics
+
+            if (!std::equal(std::begin(checked.index), std::end(checked.index), std::begin(newGrid.index)))
                 throw std::invalid_argument {"Grid invalid!"};
+
+            grid = {checked};
         }
 
         /** \brief Checks if a Grid is valid, including grid array and index
@@ -231,53 +308,229 @@ namespace Grid15
             return validGridArray(grid.gridArray) && validIndex(grid.gridArray, grid.index);//fixme validGridArray is used in valid index already (unnnessary, but again unavoidable)
         }
 
+        namespace
+        {
+            typedef std::array<std::uint8_t, Grid::CELLS> cells_t;///<A grid array in reading order
+
+            /** \brief Gets the random engine of the calling thread
+             *
+             * Each thread gets its own engine, seeded once from std::random_device, so boards made at the same time
+             * (even in the same clock tick or on different threads) are still different
+             *
+             * \return The random engine of this thread
+             */
+            std::mt19937_64 &randomEngine()
+            {
+                thread_local std::mt19937_64 engine
+                {
+                    []
+                    {
+                        std::random_device device {};
+                        std::seed_seq seed {device(), device(), device(), device()};
+                        return std::mt19937_64 {seed};
+                    }()
+                };
+
+                return engine;
+            }
+
+            /** \brief Shuffles the tiles into a random solvable order in one pass
+             *
+             * Half of all permutations cannot be solved. Instead of shuffling again until one can be, swapping any two tiles that are not
+             * the no tile flips the parity of the inversions without moving the no tile, which always makes an unsolvable order solvable.
+             * Since this swap pairs every unsolvable order with exactly one solvable one, every solvable order is still equally likely.
+             *
+             * \return Random, solvable cells
+             */
+            cells_t shuffleSolvable()
+            {
+                cells_t cells {};
+
+                for (std::uint_fast32_t i {0}; i < Grid::CELLS; ++i)
+                    cells[i] = {Grid::GOAL_GRID[i / Grid::COLUMS][i % Grid::COLUMS]};
+
+                std::shuffle(std::begin(cells), std::end(cells), randomEngine());
+
+                //count inversions using a mask of the tiles seen so far; the ones greater than this tile are inversions
+                std::uint_fast32_t seen {0};
+                std::uint_fast32_t numberOfInversions {0};
+                std::uint_fast32_t noTileCell {0};
+
+                for (std::uint_fast32_t i {0}; i < Grid::CELLS; ++i)
+                {
+                    if (cells[i] == Grid::NO_TILE)
+                        noTileCell = {i};
+                    else
+                    {
+                        numberOfInversions += static_cast<std::uint_fast32_t> (__builtin_popcount(seen >> cells[i]));
+                        seen |= 1u << cells[i];
+                    }
+                }
+
+                //same rule as solvableGrid
+                const bool evenInversions {(numberOfInversions % 2) == 0};
+                const bool noTileOnEvenRow {((Grid::ROWS - (noTileCell / Grid::COLUMS)) % 2) == 0};
+
+                if (evenInversions == noTileOnEvenRow)//unsolvable, so swap the first two tiles that are not the no tile
+                {
+                    const std::uint_fast32_t first {noTileCell == 0 ? 1u : 0u};
+                    const std::uint_fast32_t second {noTileCell <= 1 ? 2u : 1u};
+
+                    std::swap(cells[first], cells[second]);
+                }
+
+                return cells;
+            }
+        }
+
+        /** \brief Seeds the random engine used by generateRandomGridArray and generateRandomGrid
+         *
+         * Only the calling thread's engine is seeded, so the same seed gives the same boards on that thread. Without this each thread is
+         * seeded from std::random_device
+         *
+         * \param seed The new seed
+         */
+        void seedRandom(const std::uint64_t seed)
+        {
+            randomEngine().seed(seed);
+        }
+
         /** \brief Creates a new, random, and solvable grid array
          *
          * \return A new grid array
          */
         Grid15::Grid::gridArray_t generateRandomGridArray()
         {
-            //FIXME get rid of single dimentional intermediary array
-            //we have to have it because otherwise std::shuffle only shuffles rows themselves, not inside or in between
-            std::array<std::uint8_t, 16> tempGrid
-            {
-                1,  2,  3,  4,
-                5,  6,  7,  8,
-                9,  10, 11, 12,
-                13, 14, 15, Grid::NO_TILE
-            };
+            const cells_t cells {shuffleSolvable()};
+            Grid::gridArray_t gridArray {};
+
+            for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
+                for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
+                    gridArray[i][j] = {cells[(i * Grid::COLUMS) + j]};
 
-            Grid::gridArray_t multiDimentional {};//a normal gridArray
+            return gridArray;
+        }
 
-            //random number generator with seed
-            auto rd = std::default_random_engine(std::chrono::system_clock::now().time_since_epoch().count());
+        /** \brief Creates a new, random, and solvable Grid
+         *
+         * The index is filled in along with the grid array, so reIndex is not needed
+         *
+         * \return A new Grid
+         */
+        Grid generateRandomGrid()
+        {
+            const cells_t cells {shuffleSolvable()};
+            Grid::gridArray_t gridArray {};
+            Grid::index_t index {};
 
-            do
+            for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
             {
-                std::shuffle(std::begin(tempGrid), std::end(tempGrid), rd);//shuffle grid randomly with rd
-
-                //copy 2d to 3d array
-                for (std::uint_fast32_t i {0}; i < 4; ++i)
-                    for (std::uint_fast32_t j {0}; j < 4; ++j)
-                        multiDimentional[i][j] = {tempGrid[(i * 4) + j]};
+                for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
+                {
+                    const std::uint8_t tile {cells[(i * Grid::COLUMS) + j]};
 
+                    gridArray[i][j] = {tile};
+                    index[tile][0] = {static_cast<std::uint8_t> (i)};
+                    index[tile][1] = {static_cast<std::uint8_t> (j)};
+                }
             }
-            while (!solvableGrid(multiDimentional));//check if grid is solvable
 
-            return multiDimentional;
+            return Grid {gridArray, index};
         }
 
-        /** \brief Creates a new, random, and solvable Grid
+        /** \brief Fills a buffer with new, random, and solvable grid arrays
          *
-         * \return A new Grid
+         * \param gridArrays Where to put the grid arrays
+         * \param count How many grid arrays to make
          */
-        Grid generateRandomGrid()
+        void generateRandomGridArrays(Grid::gridArray_t *gridArrays, const std::size_t count)
+        {
+            for (std::size_t i {0}; i < count; ++i)
+                gridArrays[i] = {generateRandomGridArray()};
+        }
+
+        /** \brief Fills a buffer with new, random, and solvable Grids
+         *
+         * \param grids Where to put the Grids
+         * \param count How many Grids to make
+         */
+        void generateRandomGrids(Grid *grids, const std::size_t count)
         {
-            Grid newGrid {generateRandomGridArray()};//set the new grid array here
+            for (std::size_t i {0}; i < count; ++i)
+                grids[i] = {generateRandomGrid()};
+        }
+
+        /** \brief Creates a Grid by sliding random tiles, starting from Grid::GOAL_GRID
+         *
+         * Every Grid reached this way is solvable, so unlike generateRandomGrid nothing needs checking and it takes O(length) time.
+         * The tile just slid is never slid straight back. The optimal solution is at most length moves, with the same parity (odd or even).
+         *
+         * \param length The number of tiles to slide
+         * \param seed The seed for the random engine; the same seed and length always give the same Grid
+         * \param noRevisits Also never slide into a Grid the walk has already been through, using a set of Grid::hash values;
+         * if every move would revisit one, the walk backs up a move and tries another way
+         * \return The scrambled Grid
+         */
+        Grid scrambleGrid(const std::uint_fast32_t length, const std::uint64_t seed, const bool noRevisits)
+        {
+            std::mt19937_64 engine {seed};
+            std::unordered_set<std::uint64_t> visited {};
+            std::vector<std::uint8_t> path {};//the tiles slid so far, so a stuck walk can back up
+
+            Grid grid {Grid::GOAL_GRID};
+            reIndex(grid);
+
+            if (noRevisits)
+            {
+                visited.reserve(length + 1);
+                visited.insert(grid.hash);
+            }
+
+            path.reserve(length);
 
-            reIndex(newGrid);//creates a new index
+            while (path.size() < length)
+            {
+                //the tiles around the no tile, except the one just slid
+                const std::uint8_t previous {path.empty() ? static_cast<std::uint8_t> (Grid::NO_TILE) : path.back()};
+                const std::uint_fast32_t noTileY {grid.index[Grid::NO_TILE][0]};
+                const std::uint_fast32_t noTileX {grid.index[Grid::NO_TILE][1]};
+                std::array<std::uint8_t, 4> tiles {};
+                std::uint_fast32_t tileCount {0};
+
+                if (noTileY > 0 && grid.gridArray[noTileY - 1][noTileX] != previous)
+                    tiles[tileCount++] = {grid.gridArray[noTileY - 1][noTileX]};
+                if (noTileY < Grid::Y_MAX && grid.gridArray[noTileY + 1][noTileX] != previous)
+                    tiles[tileCount++] = {grid.gridArray[noTileY + 1][noTileX]};
+                if (noTileX > 0 && grid.gridArray[noTileY][noTileX - 1] != previous)
+                    tiles[tileCount++] = {grid.gridArray[noTileY][noTileX - 1]};
+                if (noTileX < Grid::X_MAX && grid.gridArray[noTileY][noTileX + 1] != previous)
+                    tiles[tileCount++] = {grid.gridArray[noTileY][noTileX + 1]};
+
+                std::shuffle(std::begin(tiles), std::begin(tiles) + tileCount, engine);
+
+                bool moved {false};
+
+                for (std::uint_fast32_t i {0}; i < tileCount && !moved; ++i)
+                {
+                    swapTileUnchecked(tiles[i], grid);
+
+                    if (!noRevisits || visited.insert(grid.hash).second)
+                    {
+                        path.push_back(tiles[i]);
+                        moved = {true};
+                    }
+                    else
+                        swapTileUnchecked(tiles[i], grid);//been here already, so slide it back
+                }
 
-            return newGrid;
+                if (!moved)//stuck; back up one move, and since this Grid stays visited the walk will not come back to it
+                {
+                    swapTileUnchecked(path.back(), grid);
+                    path.pop_back();
+                }
+            }
+
+            return grid;
         }
 
         /** \brief Checks if a grid is solvable or not.
@@ -291,8 +544,8 @@ namespace Grid15
         bool solvableGrid(const Grid::gridArray_t &gridArray)
         {
             //create a new grid with an index
-            Grid tempGrid {gridArray};
-            reIndex(tempGrid);
+            Grid tempGrid {};
+            safeCopy(gridArray, tempGrid);//throws if the grid array is invalid
 
             return solvableGrid(tempGrid);
         }
@@ -310,64 +563,216 @@ namespace Grid15
         {
             if (validGrid(grid))
             {
-                //calculate number of inversions
-                std::array<std::uint8_t, 16> linearGrid {};
-                std::uint_fast32_t numberOfInversions {0};
+                //the inversion parity is kept in Grid::Metrics, so only the no tile's row is left to find
+                //this uses [0][0] as y coordinate, onece flipped coordinate issue is fixed this should be changed to [0][1]
+                //works for now
+                const bool noTileOnEvenRow {((Grid::ROWS - grid.index[Grid::NO_TILE][0]) % 2) == 0};
+
+                return grid.metrics.oddInversions == noTileOnEvenRow;//even inversions need the no tile on an odd row from the bottom, and the reverse
+            }
+            else
+                throw std::invalid_argument {"Grid invalid!"};
+        }
+
+        /** \brief Finds a shortest list of moves that solves a Grid
+         *
+         * See Solver::solve for details about the search
+         *
+         * \param grid The Grid to solve
+         * \return The tiles to slide (in order) to reach Grid::GOAL_GRID; empty if the Grid is already won
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array) or cannot be solved
+         */
+        std::vector<std::uint8_t> solve(const Grid &grid)
+        {
+            return Solver::solve(grid).moves;
+        }
 
-                //copy to 1 dimentional array
-                for (std::uint_fast32_t i {0}; i < 4; ++i)
-                    for (std::uint_fast32_t j {0}; j < 4; ++j)
-                        linearGrid[(i * 4) + j] = {grid.gridArray[i][j]};
+        /** \brief Finds a shortest list of moves that solves a Grid using pattern databases; much faster on hard Grids
+         *
+         * \param grid The Grid to solve
+         * \param database The pattern databases to use
+         * \return The tiles to slide (in order) to reach Grid::GOAL_GRID; empty if the Grid is already won
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array) or cannot be solved
+         */
+        std::vector<std::uint8_t> solve(const Grid &grid, const PatternDatabase &database)
+        {
+            return Solver::solve(grid, database).moves;
+        }
 
-                //look for inversions by comparing pairs of tiles
-                //Starts with 1st and 2nd then 1st and 3rd up to 1st and 16th, then repeats with 2nd and 3rd and so on
-                for (std::uint_fast32_t i {0}; i < 15; ++i)//last number cannot have any inversions so we might as well skip it
+        /** \brief Finds a shortest list of moves that solves a Grid using walking distance; faster than plain solve without needing pattern databases
+         *
+         * \param grid The Grid to solve
+         * \param tables The walking distance tables to use
+         * \return The tiles to slide (in order) to reach Grid::GOAL_GRID; empty if the Grid is already won
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array) or cannot be solved
+         */
+        std::vector<std::uint8_t> solve(const Grid &grid, const WalkingDistance &tables)
+        {
+            return Solver::solve(grid, tables).moves;
+        }
+
+        /** \brief Writes the numbers of a grid array in reading order, separated by spaces; the format GridHelp::parseGridArray reads
+         *
+         * \param gridArray The grid array
+         * \param buffer Where to write; must have room for GridHelp::FORMATTED_GRID_SIZE characters
+         * \return How many characters were written (no null terminator is added)
+         */
+        std::size_t formatGridArray(const Grid::gridArray_t &gridArray, char *buffer) noexcept
+        {
+            char *position {buffer};
+
+            for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
+                for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
                 {
-                    for (std::uint_fast32_t j {1}; j < (16 - i); ++j)//start at the tile after i until the end of the grid
+                    if (position != buffer)
+                        *(position++) = ' ';
+
+                    position = {std::to_chars(position, buffer + FORMATTED_GRID_SIZE, static_cast<unsigned int> (gridArray[i][j])).ptr};
+                }
+
+            return static_cast<std::size_t> (position - buffer);
+        }
+
+        /** \brief Reads the numbers of a grid array in reading order, separated by spaces, tabs, commas and/or newlines
+         *
+         * Numbers that cannot be a tile are read as 255, so the grid array is not valid; the grid array is not checked otherwise
+         *
+         * \param first The first character to read
+         * \param last One past the last character to read
+         * \param gridArray The grid array to read to
+         * \return One past the last digit of the last number, or nullptr if there were not enough numbers
+         */
+        const char *parseGridArray(const char *first, const char *last, Grid::gridArray_t &gridArray) noexcept
+        {
+            for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
+                for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
+                {
+                    while (first != last && (*first == ' ' || *first == ',' || *first == '\t' || *first == '\n' || *first == '\r'))
+                        ++first;
+
+                    int number {};
+                    const std::from_chars_result result {std::from_chars(first, last, number)};
+
+                    if (result.ec != std::errc {})
+                        return nullptr;
+
+                    first = {result.ptr};
+                    gridArray[i][j] = {static_cast<std::uint8_t> ((number >= 0 && number < static_cast<int> (Grid::CELLS)) ? number : 255)};
+                }
+
+            return first;
+        }
+
+        /** \brief Reads a sequence of moves and checks that each one is valid, in order, on a Grid
+         *
+         * A move is either a tile number or one of U, D, L and R (or lowercase), the way the no tile moves. Moves may be
+         * separated by spaces, tabs and/or commas; letters do not need to be, so "UULDR" is five moves.
+         *
+         * \param moves The moves
+         * \param grid The Grid the moves start on; it is not changed
+         * \return The tiles to slide, in order; every one is valid after the ones before it
+         * \throw std::invalid_argument If a move cannot be read or is not valid, saying which one
+         */
+        std::vector<std::uint8_t> parseMoves(const std::string &moves, const Grid &grid)
+        {
+            if (!validGridArray(grid.gridArray))
+                throw std::invalid_argument {"Grid invalid!"};
+
+            std::vector<std::uint8_t> tiles {};
+            Grid board {grid};//moves are made on a copy, so nothing changes unless every one is valid
+
+            const char *position {moves.data()};
+            const char *last {moves.data() + moves.size()};
+
+            while (position != last)
+            {
+                if (*position == ' ' || *position == ',' || *position == '\t' || *position == '\r' || *position == '\n')
+                {
+                    ++position;
+                    continue;
+                }
+
+                const std::string moveName {"Move " + std::to_string(tiles.size() + 1)};
+                std::uint8_t tileNum {Grid::NO_TILE};
+
+                if (*position >= '0' && *position <= '9')
+                {
+                    unsigned int number {};
+                    const std::from_chars_result result {std::from_chars(position, last, number)};
+
+                    position = {result.ptr};
+
+                    if (result.ec != std::errc {} || number > Grid::TILE_MAX)
+                        throw std::invalid_argument {moveName + " is not a tile!"};
+
+                    tileNum = {static_cast<std::uint8_t> (number)};
+                }
+                else
+                {
+                    //the tile next to the no tile in the direction given
+                    std::int_fast32_t y {board.index[Grid::NO_TILE][0]};
+                    std::int_fast32_t x {board.index[Grid::NO_TILE][1]};
+
+                    switch (*position)
                     {
-                        if ((linearGrid[i] != Grid::NO_TILE) && (linearGrid[i + j] != Grid::NO_TILE))//if none of the two compared tiles are the no tile
-                            if ((linearGrid[i] > linearGrid[i + j]))//if first tile is greater than other tile
-                                ++numberOfInversions;
+                        case 'U':
+                        case 'u':
+                            --y;
+                            break;
+                        case 'D':
+                        case 'd':
+                            ++y;
+                            break;
+                        case 'L':
+                        case 'l':
+                            --x;
+                            break;
+                        case 'R':
+                        case 'r':
+                            ++x;
+                            break;
+                        default:
+                            throw std::invalid_argument {moveName + " is not a tile or U, D, L or R!"};
                     }
-                }
 
-                //find if inversions are even
-                bool evenInversions {(numberOfInversions % 2) == 0};
+                    ++position;
 
-                //find if no tile y coordinate is on an even row from the bottom
-                //this uses [0][0] as y coordinate, onece flipped coordinate issue is fixed this should be changed to [0][1]
-                //works for now
-                bool noTileOnEvenRow {((4 - grid.index[0][0]) % 2) == 0};
+                    if (y < 0 || y >= static_cast<std::int_fast32_t> (Grid::ROWS) || x < 0 || x >= static_cast<std::int_fast32_t> (Grid::COLUMS))
+                        throw std::invalid_argument {moveName + " moves off the board!"};
+
+                    tileNum = {board.gridArray[y][x]};
+                }
 
-                return evenInversions != noTileOnEvenRow;
+                if (!validMoveUnchecked(tileNum, board))//the grid was checked once above, and stays valid
+                    throw std::invalid_argument {moveName + " is not a valid move!"};
+
+                swapTileUnchecked(tileNum, board);
+                tiles.push_back(tileNum);
             }
-            else
-                throw std::invalid_argument {"Grid invalid!"};
+
+            return tiles;
         }
 
         /** \brief Saves a Grid to disk (not the index)
          *
          * \param saveFile The save file
          * \param grid The Grid to save
-         * \throw std::ios_base::failure From std::ifstream; if a file operation goes wrong
+         * \throw std::ios_base::failure From std::ofstream; if a file operation goes wrong
          * \throw std::invalid_argument If the Grid is not valid (ignores index)
          */
         void save(const std::string& saveFile, const Grid& grid)
         {
             if (validGridArray(grid.gridArray))
             {
+                std::array<char, FORMATTED_GRID_SIZE + 1> saveFileBuffer;//the whole file, so it is written with one call
+                std::size_t size {formatGridArray(grid.gridArray, saveFileBuffer.data())};
+                saveFileBuffer[size++] = {'\n'};
+
                 std::ofstream saveFileStream {};
                 saveFileStream.exceptions(saveFileStream.failbit | saveFileStream.badbit);//to throw exceptions if something goes wrong
-                saveFileStream.open(saveFile);
-
-                std::string saveFileBuffer {};//to avoid to many write calls and therefor speed up the process
+                saveFileStream.open(saveFile, std::ios::binary);
 
-                //write grid to buffer
-                for (std::uint_fast32_t i {0}; i < 4; ++i)
-                    for (std::uint_fast32_t j {0}; j < 4; ++j)
-                        saveFileBuffer += {std::to_string(static_cast<int> (grid.gridArray[i][j])) + " "};
-
-                saveFileStream << saveFileBuffer;//store grid to file with one write
+                saveFileStream.write(saveFileBuffer.data(), static_cast<std::streamsize> (size));
                 saveFileStream.close();
             }
             else
@@ -378,33 +783,108 @@ namespace Grid15
          *
          * \param saveFile The save file
          * \param grid The Grid to load to
-         * \throw std::ios_base::failure From std::ifstream; if a file operation goes wrong
+         * \throw std::ios_base::failure From std::ifstream; if a file operation goes wrong or the file does not have a grid array
          * \throw std::invalid_argument If the newly loaded Grid is not valid
          */
         void load(const std::string& saveFile, Grid& grid)
         {
+            std::ifstream saveFileStream {};
+            saveFileStream.exceptions(saveFileStream.failbit | saveFileStream.badbit);//to throw exceptions if something goes wrong
+            saveFileStream.open(saveFile, std::ios::binary);
+            saveFileStream.exceptions(saveFileStream.badbit);//a save file is shorter than the buffer, so reaching the end is expected
+
+            constexpr std::size_t SAVE_FILE_BUFFER_SIZE {256};//saved files are GridHelp::FORMATTED_GRID_SIZE + 1 characters; leaves room for hand edited ones
+            std::array<char, SAVE_FILE_BUFFER_SIZE> saveFileBuffer;//the whole file, so it is read with one call
+            saveFileStream.read(saveFileBuffer.data(), saveFileBuffer.size());
+            const char *end {saveFileBuffer.data() + saveFileStream.gcount()};
+
+            saveFileStream.close();
+
             Grid::gridArray_t newGridArray {};//new grid array to store grid
 
+            if (parseGridArray(saveFileBuffer.data(), end, newGridArray) == nullptr)
+                throw std::ios_base::failure {"Could not read a grid from " + saveFile};
+
+            safeCopy(newGridArray, grid);//this creates a new index along the way, and throws an exception if the grid is invalid
+        }
+
+        /** \brief Saves a Grid and its MoveHistory to disk
+         *
+         * The history is on a second line starting with "history", which GridHelp::load(const std::string &, Grid &) skips
+         *
+         * \param saveFile The save file
+         * \param grid The Grid to save
+         * \param history The moves made on the Grid
+         * \throw std::ios_base::failure From std::ofstream; if a file operation goes wrong
+         * \throw std::invalid_argument If the Grid is not valid (ignores index)
+         */
+        void save(const std::string& saveFile, const Grid& grid, const MoveHistory &history)
+        {
+            if (validGridArray(grid.gridArray))
+            {
+                std::string saveFileBuffer(FORMATTED_GRID_SIZE, ' ');//the whole file, so it is written with one call
+                saveFileBuffer.resize(formatGridArray(grid.gridArray, saveFileBuffer.data()));
+                saveFileBuffer += {"\nhistory " + history.toString() + "\n"};
+
+                std::ofstream saveFileStream {};
+                saveFileStream.exceptions(saveFileStream.failbit | saveFileStream.badbit);//to throw exceptions if something goes wrong
+                saveFileStream.open(saveFile, std::ios::binary);
+
+                saveFileStream.write(saveFileBuffer.data(), static_cast<std::streamsize> (saveFileBuffer.size()));
+                saveFileStream.close();
+            }
+            else
+                throw std::invalid_argument {"Grid invalid!"};
+        }
+
+        /** \brief Loads a Grid (and recreates the index) and its MoveHistory from disk
+         *
+         * Save files without a history load with an empty one
+         *
+         * \param saveFile The save file
+         * \param grid The Grid to load to
+         * \param history The MoveHistory to load to
+         * \throw std::ios_base::failure From std::ifstream; if a file operation goes wrong or the file does not have a grid array
+         * \throw std::invalid_argument If the newly loaded Grid is not valid, or the history is not valid or does not match it
+         */
+        void load(const std::string& saveFile, Grid& grid, MoveHistory &history)
+        {
             std::ifstream saveFileStream {};
             saveFileStream.exceptions(saveFileStream.failbit | saveFileStream.badbit);//to throw exceptions if something goes wrong
-            saveFileStream.open(saveFile);
+            saveFileStream.open(saveFile, std::ios::binary);
 
-            short temp {};
+            std::ostringstream saveFileBuffer {};
+            saveFileBuffer << saveFileStream.rdbuf();//the whole file, so it is read with one pass
+            saveFileStream.close();
 
-            for (std::uint_fast32_t i {0}; i < 4; ++i)
-                for (std::uint_fast32_t j {0}; j < 4; ++j)
-                {
-                    //FIXME extraction right into newGrid even though uint8_t = unsigned char (extract number not character)
-                    saveFileStream >> temp;
-                    newGridArray[i][j] = {static_cast<std::uint8_t> (temp)};
-                }
+            const std::string contents {saveFileBuffer.str()};
+            Grid::gridArray_t newGridArray {};//new grid array to store grid
 
-            saveFileStream.close();
+            if (parseGridArray(contents.data(), contents.data() + contents.size(), newGridArray) == nullptr)
+                throw std::ios_base::failure {"Could not read a grid from " + saveFile};
 
-            safeCopy(newGridArray, grid);//this creates a new index along the way, and throws an exception if the grid is invalid
+            Grid newGrid {};
+            safeCopy(newGridArray, newGrid);//this creates a new index along the way, and throws an exception if the grid is invalid
+
+            MoveHistory newHistory {};
+            const std::size_t historyStart {contents.find("\nhistory ")};
+
+            if (historyStart != std::string::npos)
+            {
+                const std::size_t first {historyStart + 9};//after "\nhistory "
+                const std::size_t last {contents.find_first_of("\r\n", first)};
+
+                newHistory = {MoveHistory::fromString(contents.substr(first, last - first))};
+
+                if (!newHistory.matches(newGrid))
+                    throw std::invalid_argument {"MoveHistory does not match the Grid!"};
+            }
+
+            grid = {newGrid};
+            history = {newHistory};
         }
 
-        /** \brief Reads the grid array of a Grid and updates its index
+        /** \brief Reads the grid array of a Grid and updates its index, hash and metrics
          *
          * \param grid The Grid to change
          * \throw std::invalid_argument If the grid array is not valid
@@ -413,12 +893,15 @@ namespace Grid15
         {
             if (validGridArray(grid.gridArray))
             {
-                for (std::uint_fast32_t i {0}; i < 4; ++i)
-                    for (std::uint_fast32_t j {0}; j < 4; ++j)
+                for (std::uint_fast32_t i {0}; i < Grid::ROWS; ++i)
+                    for (std::uint_fast32_t j {0}; j < Grid::COLUMS; ++j)
                     {
                         grid.index[grid.gridArray[i][j]][0] = {static_cast<std::uint8_t> (i)};//find tile's y coordinate and copy to index
                         grid.index[grid.gridArray[i][j]][1] = {static_cast<std::uint8_t> (j)};//find tile's x coordinate and copy to index
                     }
+
+                grid.hash = {Grid::hashGridArray(grid.gridArray)};
+                grid.metrics = {Grid::measureGridArray(grid.gridArray)};
             }
             else
                 throw std::invalid_argument {"Grid invalid!"};
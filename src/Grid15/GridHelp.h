@@ -25,10 +25,15 @@
 
 
 #include "Grid15/Grid.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+#include "Grid15/MoveHistory.h"
 
 #include <cstdint>
+#include <cstddef>
 #include <string>
 #include <array>
+#include <vector>
 
 
 namespace Grid15
@@ -48,6 +53,11 @@ namespace Grid15
         bool validMove(const std::uint8_t tileY, const std::uint8_t tileX, const Grid &grid);
         bool hasWon(const Grid &grid);
 
+        //these trust that the Grid is valid and check nothing else; see ValidatedGrid
+        bool validMoveUnchecked(const std::uint8_t tileNum, const Grid &grid) noexcept;
+        void swapTileUnchecked(const std::uint8_t tileNum, Grid &grid) noexcept;
+        bool hasWonUnchecked(const Grid &grid) noexcept;
+
         void safeCopy(const Grid::gridArray_t &newGrid, Grid &grid);
         void safeCopy(const Grid &newGrid, Grid &grid);
 
@@ -59,13 +69,30 @@ namespace Grid15
         void swapTile(const std::uint8_t tileY, const std::uint8_t tileX, Grid &grid);
         void swapTile(const std::uint8_t tileNum, Grid &grid);
 
+        void seedRandom(const std::uint64_t seed);
         Grid::gridArray_t generateRandomGridArray();
         Grid generateRandomGrid();
+        void generateRandomGridArrays(Grid::gridArray_t *gridArrays, const std::size_t count);
+        void generateRandomGrids(Grid *grids, const std::size_t count);
+        Grid scrambleGrid(const std::uint_fast32_t length, const std::uint64_t seed, const bool noRevisits = false);
         bool solvableGrid(const Grid &grid);
         bool solvableGrid(const Grid::gridArray_t &gridArray);
 
+        std::vector<std::uint8_t> solve(const Grid &grid);
+        std::vector<std::uint8_t> solve(const Grid &grid, const PatternDatabase &database);
+        std::vector<std::uint8_t> solve(const Grid &grid, const WalkingDistance &tables);
+
+        constexpr std::size_t FORMATTED_GRID_SIZE {Grid::CELLS * 3};///<The most characters GridHelp::formatGridArray writes
+
+        std::size_t formatGridArray(const Grid::gridArray_t &gridArray, char *buffer) noexcept;
+        const char *parseGridArray(const char *first, const char *last, Grid::gridArray_t &gridArray) noexcept;
+
+        std::vector<std::uint8_t> parseMoves(const std::string &moves, const Grid &grid);
+
         void save(const std::string &saveFile, const Grid15::Grid &grid);
+        void save(const std::string &saveFile, const Grid15::Grid &grid, const MoveHistory &history);
         void load(const std::string &saveFile, Grid &grid);
+        void load(const std::string &saveFile, Grid &grid, MoveHistory &history);
 
         void reIndex(Grid &grid);
     }
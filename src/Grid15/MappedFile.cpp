@@ -0,0 +1,161 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/MappedFile.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <fstream>
+
+#if !(defined(WIN32) || defined(_WIN32) || defined(_WIN64))
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+
+namespace Grid15
+{
+    namespace MappedFile
+    {
+        /** \brief Maps a whole file into memory, read only
+         *
+         * On systems without mmap the file is read into memory instead
+         *
+         * \param file The file to map
+         * \param size Set to the size of the file
+         * \param access How the memory will be read; random access turns off reading ahead, sequential access reads further ahead
+         * \return The memory, which is unmapped when the last copy of the pointer is gone; nullptr if the file is empty
+         * \throw std::ios_base::failure If the file cannot be opened or mapped
+         */
+        std::shared_ptr<const void> map(const std::string &file, std::size_t &size, const Access access)
+        {
+            #if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+            static_cast<void> (access);
+
+            std::ifstream fileStream {};
+            fileStream.exceptions(fileStream.failbit | fileStream.badbit);//to throw exceptions if something goes wrong
+            fileStream.open(file, std::ios::binary | std::ios::ate);
+
+            size = static_cast<std::size_t> (fileStream.tellg());
+            fileStream.seekg(0);
+
+            std::shared_ptr<std::uint8_t> memory {new std::uint8_t [size], std::default_delete<std::uint8_t[]> {}};
+            fileStream.read(reinterpret_cast<char *> (memory.get()), size);
+
+            return memory;
+            #else
+            const int fileDescriptor {open(file.c_str(), O_RDONLY | O_CLOEXEC)};
+            if (fileDescriptor == -1)
+                throw std::ios_base::failure {"Could not open " + file};
+
+            struct stat fileStatus {};
+            if (fstat(fileDescriptor, &fileStatus) == -1)
+            {
+                close(fileDescriptor);
+                throw std::ios_base::failure {"Could not read " + file};
+            }
+
+            size = static_cast<std::size_t> (fileStatus.st_size);
+
+            if (size == 0)//mmap cannot map nothing
+            {
+                close(fileDescriptor);
+                return nullptr;
+            }
+
+            //shared so every process using the file uses the same pages of the page cache
+            void *memory {mmap(nullptr, size, PROT_READ, MAP_SHARED, fileDescriptor, 0)};
+            close(fileDescriptor);//the mapping stays after the file is closed
+
+            if (memory == MAP_FAILED)
+                throw std::ios_base::failure {"Could not map " + file};
+
+            madvise(memory, size, (access == Access::RANDOM) ? MADV_RANDOM : MADV_SEQUENTIAL);
+
+            return std::shared_ptr<const void> {memory, [size](const void *mapped)
+            {
+                munmap(const_cast<void *> (mapped), size);
+            }};
+            #endif
+        }
+
+        /** \brief Changes how part of a mapped file will be read, like MappedFile::map's access
+         *
+         * Does nothing on systems without mmap, where the whole file is already in memory
+         *
+         * \param data The start of the part, inside memory from MappedFile::map
+         * \param size How many bytes the part is
+         * \param access How the part will be read
+         */
+        void advise(const void *data, const std::size_t size, const Access access)
+        {
+            #if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+            static_cast<void> (data);
+            static_cast<void> (size);
+            static_cast<void> (access);
+            #else
+            //madvise needs the start of a page
+            const std::uintptr_t pageSize {static_cast<std::uintptr_t> (sysconf(_SC_PAGESIZE))};
+            const std::uintptr_t start {reinterpret_cast<std::uintptr_t> (data)};
+            const std::uintptr_t pageStart {start - (start % pageSize)};
+
+            madvise(reinterpret_cast<void *> (pageStart), size + (start - pageStart), (access == Access::RANDOM) ? MADV_RANDOM : MADV_SEQUENTIAL);
+            #endif
+        }
+
+        /** \brief A quick 64 bit FNV-1a style checksum, taken 8 bytes at a time
+         *
+         * Checksumming two blocks one after the other, passing the first checksum as the start of the second, is the same as
+         * checksumming both at once as long as the first block's size is a multiple of 8
+         *
+         * \param data The bytes to check
+         * \param size How many bytes there are
+         * \param start MappedFile::CHECKSUM_START, or the checksum of the bytes before these
+         * \return The checksum
+         */
+        std::uint64_t checksum(const std::uint8_t *data, const std::size_t size, const std::uint64_t start)
+        {
+            constexpr std::uint64_t PRIME {0x100000001B3};
+            std::uint64_t hash {start};
+
+            std::size_t i {0};
+            for (; i + 8 <= size; i += 8)
+            {
+                std::uint64_t word {};
+                std::memcpy(&word, data + i, 8);
+                hash = {(hash ^ word) * PRIME};
+            }
+
+            for (; i < size; ++i)
+                hash = {(hash ^ data[i]) * PRIME};
+
+            return hash;
+        }
+    }
+}
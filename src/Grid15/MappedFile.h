@@ -0,0 +1,52 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <memory>
+
+
+namespace Grid15
+{
+    /** \brief Read only memory mapped files and checksums, for the binary files Grid15 saves (see PatternDatabase and Corpus)
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    namespace MappedFile
+    {
+        ///How a mapped file will be read, so the system can read ahead (or not)
+        enum class Access {RANDOM, SEQUENTIAL};
+
+        constexpr std::uint64_t CHECKSUM_START {0xCBF29CE484222325};///<The checksum of nothing; pass a previous checksum instead to continue it
+
+        std::shared_ptr<const void> map(const std::string &file, std::size_t &size, const Access access);
+        void advise(const void *data, const std::size_t size, const Access access);
+        std::uint64_t checksum(const std::uint8_t *data, const std::size_t size, const std::uint64_t start = CHECKSUM_START);
+    }
+}
+#endif //MAPPEDFILE_H
@@ -0,0 +1,292 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/MoveHistory.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/PackedGrid.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <system_error>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    /* Moves */
+    /** \brief Slides a tile and remembers the move, forgetting any moves that could have been redone
+     *
+     * \param tileNum The tile to slide
+     * \param grid The Grid to change
+     * \throw std::invalid_argument The tile being moved is invalid, not next to the no tile or the Grid is invalid
+     */
+    void MoveHistory::slide(const std::uint8_t tileNum, Grid &grid)
+    {
+        if (!GridHelp::validMove(tileNum, grid))
+            throw std::invalid_argument {"tileNum or Grid invalid!"};
+
+        slideUnchecked(tileNum, grid);
+    }
+
+    /** \brief Slides a tile and remembers the move, trusting that the move is valid
+     *
+     * For moves that were already checked, like the ones from GridHelp::parseMoves; skips the full check in GridHelp::validMove
+     *
+     * \param tileNum The tile to slide; must be next to the no tile
+     * \param grid The Grid to change; must be valid
+     */
+    void MoveHistory::slideUnchecked(const std::uint8_t tileNum, Grid &grid)
+    {
+        //the no tile moves to where the tile is
+        const std::uint8_t tileY {grid.index[tileNum][0]};
+        const std::uint8_t tileX {grid.index[tileNum][1]};
+        const std::uint8_t noTileY {grid.index[Grid::NO_TILE][0]};
+        const std::uint8_t noTileX {grid.index[Grid::NO_TILE][1]};
+
+        Direction direction {};
+
+        if (tileY < noTileY)
+            direction = {Direction::UP};
+        else if (tileY > noTileY)
+            direction = {Direction::DOWN};
+        else if (tileX < noTileX)
+            direction = {Direction::LEFT};
+        else
+            direction = {Direction::RIGHT};
+
+        GridHelp::swapTileUnchecked(tileNum, grid);
+
+        length = {position};//a new move replaces the moves that were undone
+        set(position++, direction);
+    }
+
+    /** \brief Undoes the last move
+     *
+     * \param grid The Grid the moves were made on
+     * \return The tile that was slid back, or Grid::NO_TILE if there was nothing to undo
+     * \throw std::invalid_argument If the move cannot be undone on the Grid (it is not the Grid the moves were made on)
+     */
+    std::uint8_t MoveHistory::undo(Grid &grid)
+    {
+        if (!canUndo())
+            return Grid::NO_TILE;
+
+        //the opposite of each Direction is the one next to it
+        const Direction opposite {static_cast<Direction> (static_cast<std::uint8_t> (get(position - 1)) ^ 1)};
+        const std::uint8_t tileNum {moveNoTile(opposite, grid)};
+
+        if (tileNum == Grid::NO_TILE)
+            throw std::invalid_argument {"MoveHistory does not match the Grid!"};
+
+        --position;
+        return tileNum;
+    }
+
+    /** \brief Redoes the last move undone
+     *
+     * \param grid The Grid the moves were made on
+     * \return The tile that was slid, or Grid::NO_TILE if there was nothing to redo
+     * \throw std::invalid_argument If the move cannot be redone on the Grid (it is not the Grid the moves were made on)
+     */
+    std::uint8_t MoveHistory::redo(Grid &grid)
+    {
+        if (!canRedo())
+            return Grid::NO_TILE;
+
+        const std::uint8_t tileNum {moveNoTile(get(position), grid)};
+
+        if (tileNum == Grid::NO_TILE)
+            throw std::invalid_argument {"MoveHistory does not match the Grid!"};
+
+        ++position;
+        return tileNum;
+    }
+
+    ///Forgets every move, for a new game
+    void MoveHistory::clear()
+    {
+        packed.clear();
+        length = {0};
+        position = {0};
+    }
+
+
+    /* Saving */
+    /** \brief Writes the history as text, for save files
+     *
+     * \return The number of moves stored, the number of moves done, then the packed moves in hexadecimal, separated by spaces
+     */
+    std::string MoveHistory::toString() const
+    {
+        constexpr char DIGITS[] {"0123456789abcdef"};
+
+        std::string text {std::to_string(length) + " " + std::to_string(position) + " "};
+        const std::size_t start {text.size()};
+        const std::size_t bytes {(length + 3) / 4};
+
+        text.resize(start + (bytes * 2));
+
+        for (std::size_t i {0}; i < bytes; ++i)
+        {
+            text[start + (i * 2)] = {DIGITS[packed[i] >> 4]};
+            text[start + (i * 2) + 1] = {DIGITS[packed[i] & 0xF]};
+        }
+
+        return text;
+    }
+
+    /** \brief Reads a history written by MoveHistory::toString
+     *
+     * \param text The text
+     * \return The history; check it with MoveHistory::matches before using it with a Grid
+     * \throw std::invalid_argument If the text is not a history
+     */
+    MoveHistory MoveHistory::fromString(const std::string &text)
+    {
+        const char *first {text.data()};
+        const char *last {text.data() + text.size()};
+
+        MoveHistory history {};
+
+        std::from_chars_result result {std::from_chars(first, last, history.length)};
+        if (result.ec != std::errc {} || result.ptr == last || *result.ptr != ' ')
+            throw std::invalid_argument {"MoveHistory invalid!"};
+
+        result = {std::from_chars(result.ptr + 1, last, history.position)};
+        if (result.ec != std::errc {} || history.position > history.length || (result.ptr != last && *result.ptr != ' '))
+            throw std::invalid_argument {"MoveHistory invalid!"};
+
+        const char *digits {(result.ptr == last) ? last : result.ptr + 1};
+        const std::size_t bytes {(history.length / 4) + ((history.length % 4) != 0)};//not (length + 3) / 4, which overflows for a huge length
+
+        if (bytes > static_cast<std::size_t> (last - digits))//too few digits; checked first so bytes * 2 cannot overflow either
+            throw std::invalid_argument {"MoveHistory invalid!"};
+
+        if (static_cast<std::size_t> (last - digits) != bytes * 2)
+            throw std::invalid_argument {"MoveHistory invalid!"};
+
+        history.packed.resize(bytes);
+
+        for (std::size_t i {0}; i < bytes; ++i)
+        {
+            result = {std::from_chars(digits + (i * 2), digits + (i * 2) + 2, history.packed[i], 16)};
+
+            if (result.ec != std::errc {} || result.ptr != digits + (i * 2) + 2)
+                throw std::invalid_argument {"MoveHistory invalid!"};
+        }
+
+        return history;
+    }
+
+    /** \brief Checks if every move can be undone and redone on a Grid, so it is the Grid the moves were made on
+     *
+     * Takes O(moves), so only use this when a history is loaded
+     *
+     * \param grid The Grid
+     * \return True if the history can be used with the Grid
+     */
+    bool MoveHistory::matches(const Grid &grid) const
+    {
+        Grid copy {grid};
+
+        for (std::size_t i {position}; i < length; ++i)
+            if (moveNoTile(get(i), copy) == Grid::NO_TILE)
+                return false;
+
+        copy = {grid};
+
+        for (std::size_t i {position}; i > 0; --i)
+            if (moveNoTile(static_cast<Direction> (static_cast<std::uint8_t> (get(i - 1)) ^ 1), copy) == Grid::NO_TILE)
+                return false;
+
+        return true;
+    }
+
+
+    /* Helpers */
+    ///Gets the Direction of a move
+    MoveHistory::Direction MoveHistory::get(const std::size_t move) const
+    {
+        return static_cast<Direction> ((packed[move / 4] >> (2 * (move % 4))) & 0x3);
+    }
+
+    ///Sets the Direction of a move, growing the buffer if needed
+    void MoveHistory::set(const std::size_t move, const Direction direction)
+    {
+        if (move / 4 >= packed.size())
+            packed.push_back(0);
+
+        const std::uint8_t shift {static_cast<std::uint8_t> (2 * (move % 4))};
+        packed[move / 4] = static_cast<std::uint8_t> ((packed[move / 4] & ~(0x3 << shift)) | (static_cast<std::uint8_t> (direction) << shift));
+
+        length = {(move + 1 > length) ? move + 1 : length};
+    }
+
+    /** \brief Moves the no tile of a Grid in a direction
+     *
+     * \param direction The direction
+     * \param grid The Grid to change
+     * \return The tile that was slid, or Grid::NO_TILE if the no tile would leave the board
+     */
+    std::uint8_t MoveHistory::moveNoTile(const Direction direction, Grid &grid)
+    {
+        std::uint8_t y {grid.index[Grid::NO_TILE][0]};
+        std::uint8_t x {grid.index[Grid::NO_TILE][1]};
+
+        switch (direction)
+        {
+            case Direction::UP:
+                if (y == 0)
+                    return Grid::NO_TILE;
+                --y;
+                break;
+            case Direction::DOWN:
+                if (y == Grid::ROWS - 1)
+                    return Grid::NO_TILE;
+                ++y;
+                break;
+            case Direction::LEFT:
+                if (x == 0)
+                    return Grid::NO_TILE;
+                --x;
+                break;
+            default:
+                if (x == Grid::COLUMS - 1)
+                    return Grid::NO_TILE;
+                ++x;
+                break;
+        }
+
+        const std::uint8_t tileNum {grid.gridArray[y][x]};
+        GridHelp::swapTileUnchecked(tileNum, grid);
+
+        return tileNum;
+    }
+}
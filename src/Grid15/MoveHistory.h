@@ -0,0 +1,87 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef MOVEHISTORY_H
+#define MOVEHISTORY_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/PackedGrid.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace Grid15
+{
+    /** \class MoveHistory
+     *
+     * \brief The moves of a game, for undo and redo
+     *
+     * Each move is stored as the PackedGrid::Direction the no tile moved in, 2 bits each and 4 to a byte, so 40000 moves take
+     * 10 kilobytes. Undoing moves the no tile back the opposite way, so no boards are kept, and undo and redo are both O(1).
+     * Moves that were undone can be redone until a new move is made.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class MoveHistory
+    {
+        public:
+            typedef PackedGrid::Direction Direction;///<A direction the no tile moved in
+
+
+            /* Moves */
+            void slide(const std::uint8_t tileNum, Grid &grid);
+            void slideUnchecked(const std::uint8_t tileNum, Grid &grid);
+            std::uint8_t undo(Grid &grid);
+            std::uint8_t redo(Grid &grid);
+            void clear();
+
+            ///Checks if there is a move to undo
+            bool canUndo() const {return position != 0;}
+            ///Checks if there is a move to redo
+            bool canRedo() const {return position != length;}
+            ///Gets how many moves can be undone
+            std::size_t getMoves() const {return position;}
+            ///Gets how many moves can be redone
+            std::size_t getRedoMoves() const {return length - position;}
+
+
+            /* Saving */
+            std::string toString() const;
+            static MoveHistory fromString(const std::string &text);
+            bool matches(const Grid &grid) const;
+
+        private:
+            Direction get(const std::size_t move) const;
+            void set(const std::size_t move, const Direction direction);
+            static std::uint8_t moveNoTile(const Direction direction, Grid &grid);
+
+            std::vector<std::uint8_t> packed {};///<The directions, 2 bits each, the first move in the low bits of the first byte
+            std::size_t length {0};             ///<How many moves are stored, including ones that were undone
+            std::size_t position {0};           ///<How many moves are done; the rest can be redone
+    };
+}
+#endif //MOVEHISTORY_H
@@ -0,0 +1,421 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/MoveJournal.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/MoveHistory.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <charconv>
+#include <system_error>
+#include <exception>
+#include <stdexcept>
+
+#if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+namespace Grid15
+{
+    namespace
+    {
+        /** \brief Writes a journal's generation, least significant byte first, so journals can be read on any computer
+         *
+         * \param generation The generation
+         * \param journal The journal, at its start
+         * \return If the generation was written
+         */
+        bool writeGeneration(const std::uint64_t generation, std::FILE *journal)
+        {
+            unsigned char bytes[8] {};
+
+            for (std::size_t i {0}; i < sizeof(bytes); ++i)
+                bytes[i] = static_cast<unsigned char> (generation >> (i * 8));
+
+            return std::fwrite(bytes, sizeof(bytes), 1, journal) == 1;
+        }
+
+        /** \brief Reads a journal's generation written by writeGeneration
+         *
+         * \param journalStream The journal, at its start
+         * \return The generation, or 0 if the journal is too short
+         */
+        std::uint64_t readGeneration(std::istream &journalStream)
+        {
+            unsigned char bytes[8] {};
+
+            if (!journalStream.read(reinterpret_cast<char *> (bytes), sizeof(bytes)))
+                return 0;
+
+            std::uint64_t generation {0};
+            for (std::size_t i {0}; i < sizeof(bytes); ++i)
+                generation |= static_cast<std::uint64_t> (bytes[i]) << (i * 8);
+
+            return generation;
+        }
+
+        /** \brief Flushes a file all the way to the disk
+         *
+         * \param file The file
+         * \param directory If the file is a directory (so a rename in it is on the disk too)
+         * \throw std::ios_base::failure If the file cannot be flushed
+         */
+        void syncFile(const std::string &file, const bool directory)
+        {
+            #if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+            if (directory)
+                return;//MoveFileEx with MOVEFILE_WRITE_THROUGH already flushes the rename
+
+            std::FILE *stream {std::fopen(file.c_str(), "r+b")};
+            const bool flushed {stream != nullptr && _commit(_fileno(stream)) == 0};
+
+            if (stream != nullptr)
+                std::fclose(stream);
+            #else
+            const int fileDescriptor {open(file.c_str(), (directory ? O_RDONLY | O_DIRECTORY : O_WRONLY) | O_CLOEXEC)};
+            const bool flushed {fileDescriptor != -1 && fsync(fileDescriptor) == 0};
+
+            if (fileDescriptor != -1)
+                close(fileDescriptor);
+            #endif
+
+            if (!flushed)
+                throw std::ios_base::failure {"Could not flush " + file};
+        }
+
+        /** \brief Renames a file over another in one step, so one or the other is always there
+         *
+         * \param from The new file
+         * \param to The file to replace
+         * \throw std::ios_base::failure If the file cannot be replaced
+         */
+        void replaceFile(const std::string &from, const std::string &to)
+        {
+            #if defined(WIN32) || defined(_WIN32) || defined(_WIN64)
+            const bool replaced {MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0};//std::rename will not rename over a file here
+            #else
+            const bool replaced {std::rename(from.c_str(), to.c_str()) == 0};
+            #endif
+
+            if (!replaced)
+                throw std::ios_base::failure {"Could not replace " + to};
+        }
+
+        /** \brief Gets the directory a file is in
+         *
+         * \param file The file
+         * \return The directory, or "." if the file has no directory in its name
+         */
+        std::string directoryOf(const std::string &file)
+        {
+            const std::size_t slash {file.find_last_of("/\\")};
+
+            if (slash == std::string::npos)
+                return ".";
+            else if (slash == 0)
+                return "/";
+            else
+                return file.substr(0, slash);
+        }
+    }
+
+    /* Setup */
+    /** \brief Starts journaling a game, writing a snapshot of it to the save file first
+     *
+     * \param newSaveFile The save file
+     * \param grid The game as it is now
+     * \param history The moves made in the game, to include in snapshots, or nullptr
+     * \param newCompactInterval How many moves to journal before rewriting the snapshot; at least 1
+     * \throw std::ios_base::failure If the snapshot or the journal cannot be written
+     * \throw std::invalid_argument If the Grid is not valid (ignores index)
+     */
+    MoveJournal::MoveJournal(const std::string &newSaveFile, const Grid &grid, const MoveHistory *history, const std::size_t newCompactInterval) :
+        saveFile {newSaveFile}, compactInterval {newCompactInterval == 0 ? 1 : newCompactInterval}, latest {grid}
+    {
+        if (history != nullptr)
+        {
+            latestHistory = {*history};
+            hasHistory = {true};
+        }
+
+        //newer than anything already on disk, so an old journal can never match the new snapshot
+        const std::uint64_t oldSnapshot {snapshotGeneration(saveFile)};
+        const std::uint64_t oldJournal {journalGeneration(saveFile)};
+        generation = {(oldSnapshot > oldJournal) ? oldSnapshot : oldJournal};
+
+        compact();
+    }
+
+    ///Closes the journal; everything recorded is already on disk, so nothing is lost
+    MoveJournal::~MoveJournal()
+    {
+        if (journal != nullptr)
+            std::fclose(journal);
+    }
+
+
+    /* Saving */
+    /** \brief Appends a move to the journal, rewriting the snapshot instead every MoveJournal::COMPACT_INTERVAL moves
+     *
+     * \param move The tile that was just slid, or MoveJournal::UNDO or MoveJournal::REDO after an undo or redo
+     * \throw std::ios_base::failure If the journal (or snapshot) cannot be written
+     * \throw std::invalid_argument If the move is not valid on the journaled game
+     */
+    void MoveJournal::record(const std::uint8_t move)
+    {
+        record(&move, 1);
+    }
+
+    /** \brief Appends several moves to the journal with one write, rewriting the snapshot instead every MoveJournal::COMPACT_INTERVAL moves
+     *
+     * \param moves The moves, in order (see MoveJournal::record(const std::uint8_t))
+     * \param count How many moves there are
+     * \throw std::ios_base::failure If the journal (or snapshot) cannot be written
+     * \throw std::invalid_argument If a move is not valid on the journaled game; nothing is written, and the MoveJournal should be discarded
+     */
+    void MoveJournal::record(const std::uint8_t *moves, const std::size_t count)
+    {
+        if (journal == nullptr)
+            throw std::ios_base::failure {"Journal closed"};
+
+        for (std::size_t i {0}; i < count; ++i)
+            if (!apply(moves[i], latest, latestHistory))
+                throw std::invalid_argument {"Move does not match the journaled game!"};
+
+        if (journalMoves + count >= compactInterval)
+            compact();
+        else if (count != 0)
+        {
+            //one write call; the stream is unbuffered
+            if (std::fwrite(moves, 1, count, journal) != count)
+                throw std::ios_base::failure {"Could not write " + journalFile(saveFile)};
+
+            journalMoves += count;
+        }
+    }
+
+    /** \brief Rewrites the snapshot with every move so far and starts an empty journal
+     *
+     * \throw std::ios_base::failure If the snapshot or the journal cannot be written
+     */
+    void MoveJournal::compact()
+    {
+        ++generation;
+
+        //write the new snapshot next to the old one, then swap it in all at once
+        const std::string newSnapshot {saveFile + ".new"};
+        if (hasHistory)
+            GridHelp::save(newSnapshot, latest, latestHistory);
+        else
+            GridHelp::save(newSnapshot, latest);
+
+        {
+            std::ofstream snapshotStream {};
+            snapshotStream.exceptions(snapshotStream.failbit | snapshotStream.badbit);//to throw exceptions if something goes wrong
+            snapshotStream.open(newSnapshot, std::ios::binary | std::ios::app);
+            snapshotStream << "journal " << generation << "\n";//GridHelp::load skips lines it does not know
+        }
+
+        //the new snapshot has to be on the disk before it replaces the old one, or a crash could leave a renamed but empty file
+        syncFile(newSnapshot, false);
+        replaceFile(newSnapshot, saveFile);
+        syncFile(directoryOf(saveFile), true);
+
+        if (journal != nullptr)
+            std::fclose(journal);
+
+        journal = {std::fopen(journalFile(saveFile).c_str(), "wb")};
+        journalMoves = {0};
+
+        if (journal == nullptr)
+            throw std::ios_base::failure {"Could not open " + journalFile(saveFile)};
+
+        std::setvbuf(journal, nullptr, _IONBF, 0);
+
+        if (!writeGeneration(generation, journal))
+            throw std::ios_base::failure {"Could not write " + journalFile(saveFile)};
+    }
+
+    /** \brief Rewrites the snapshot and deletes the journal, so the save file can be used without MoveJournal::load
+     *
+     * Nothing else can be recorded afterwards
+     *
+     * \throw std::ios_base::failure If the snapshot cannot be written
+     */
+    void MoveJournal::close()
+    {
+        if (journal != nullptr)
+        {
+            compact();
+
+            std::fclose(journal);
+            journal = {nullptr};
+
+            discard(saveFile);
+        }
+    }
+
+
+    /* Loading */
+    /** \brief Loads a game saved with MoveJournal (or GridHelp::save): the snapshot, then every move in its journal
+     *
+     * A journal that belongs to another snapshot is ignored, and replaying stops at the first move that is not valid
+     *
+     * \param saveFile The save file
+     * \param grid The Grid to load to
+     * \throw std::ios_base::failure From std::ifstream; if the save file cannot be read
+     * \throw std::invalid_argument If the save file's Grid is not valid
+     */
+    void MoveJournal::load(const std::string &saveFile, Grid &grid)
+    {
+        MoveHistory history {};
+        load(saveFile, grid, history);
+    }
+
+    /** \brief Loads a game and its MoveHistory saved with MoveJournal (or GridHelp::save): the snapshot, then every move in its journal
+     *
+     * A journal that belongs to another snapshot is ignored, and replaying stops at the first move that is not valid.
+     * Undos and redos are replayed as undos and redos, so the moves that can be redone are the same as before the reload.
+     *
+     * \param saveFile The save file
+     * \param grid The Grid to load to
+     * \param history The MoveHistory to load to; empty if the snapshot does not have one
+     * \throw std::ios_base::failure From std::ifstream; if the save file cannot be read
+     * \throw std::invalid_argument If the save file's Grid is not valid, or its history is not valid or does not match it
+     */
+    void MoveJournal::load(const std::string &saveFile, Grid &grid, MoveHistory &history)
+    {
+        Grid loaded {};
+        MoveHistory loadedHistory {};
+        GridHelp::load(saveFile, loaded, loadedHistory);
+
+        std::ifstream journalStream {journalFile(saveFile), std::ios::binary};
+        const std::uint64_t journaled {readGeneration(journalStream)};
+        const std::uint64_t snapshot {snapshotGeneration(saveFile)};
+
+        if (snapshot != 0 && journaled == snapshot)
+        {
+            char move {};
+
+            while (journalStream.get(move) && apply(static_cast<std::uint8_t> (move), loaded, loadedHistory)) {}
+        }
+
+        GridHelp::safeCopy(loaded, grid);
+        history = {loadedHistory};
+    }
+
+    /** \brief Deletes the journal of a save file, if there is one
+     *
+     * Call this after writing a save file without MoveJournal, so an old journal is not replayed on top of it
+     *
+     * \param saveFile The save file
+     */
+    void MoveJournal::discard(const std::string &saveFile)
+    {
+        std::remove(journalFile(saveFile).c_str());
+    }
+
+    /** \brief Gets the name of the journal of a save file
+     *
+     * \param saveFile The save file
+     * \return The save file with ".journal" added
+     */
+    std::string MoveJournal::journalFile(const std::string &saveFile)
+    {
+        return saveFile + ".journal";
+    }
+
+    /* Helpers */
+    /** \brief Makes a journaled move on a game
+     *
+     * \param move The move: the tile slid, or MoveJournal::UNDO or MoveJournal::REDO
+     * \param grid The Grid to change
+     * \param history The MoveHistory to add the move to, or undo or redo with
+     * \return If the move was made (true), or it is not valid on the game (false)
+     */
+    bool MoveJournal::apply(const std::uint8_t move, Grid &grid, MoveHistory &history)
+    {
+        try
+        {
+            if (move == UNDO)
+                return history.undo(grid) != Grid::NO_TILE;
+            else if (move == REDO)
+                return history.redo(grid) != Grid::NO_TILE;
+        }
+        catch (std::invalid_argument &e)//the history does not match the Grid
+        {
+            return false;
+        }
+
+        if (!GridHelp::validMoveUnchecked(move, grid))//the Grid is already known to be valid
+            return false;
+
+        history.slide(move, grid);
+        return true;
+    }
+
+    /** \brief Reads the generation of a snapshot from its "journal" line
+     *
+     * \param saveFile The save file
+     * \return The generation, or 0 if the file cannot be read or was not written by MoveJournal
+     */
+    std::uint64_t MoveJournal::snapshotGeneration(const std::string &saveFile)
+    {
+        std::ifstream snapshotStream {saveFile, std::ios::binary};
+        std::string line {};
+
+        while (std::getline(snapshotStream, line))
+            if (line.compare(0, 8, "journal ") == 0)
+            {
+                std::uint64_t snapshot {0};
+                const std::from_chars_result result {std::from_chars(line.data() + 8, line.data() + line.size(), snapshot)};
+
+                return (result.ec == std::errc {}) ? snapshot : 0;
+            }
+
+        return 0;
+    }
+
+    /** \brief Reads the generation of the snapshot a journal belongs to
+     *
+     * \param saveFile The save file (not the journal)
+     * \return The generation, or 0 if there is no journal
+     */
+    std::uint64_t MoveJournal::journalGeneration(const std::string &saveFile)
+    {
+        std::ifstream journalStream {journalFile(saveFile), std::ios::binary};
+        return readGeneration(journalStream);
+    }
+}
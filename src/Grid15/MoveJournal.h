@@ -0,0 +1,109 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef MOVEJOURNAL_H
+#define MOVEJOURNAL_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/MoveHistory.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+
+namespace Grid15
+{
+    /** \class MoveJournal
+     *
+     * \brief Autosaves a game by appending each move to a journal instead of rewriting the save file
+     *
+     * The save file is a snapshot written by GridHelp::save, with a "journal" line holding its generation added. Next to it, save
+     * file + ".journal" holds the generation of that snapshot (8 bytes, least significant first), then one byte per move since: the
+     * tile slid, or MoveJournal::UNDO or MoveJournal::REDO. Every
+     * MoveJournal::COMPACT_INTERVAL moves, the snapshot is rewritten with the next generation and the journal started again.
+     * MoveJournal::load replays the journal on top of the snapshot.
+     *
+     * The snapshot is replaced by flushing a new file to the disk and renaming it over the old one, and a journal only counts if its
+     * generation matches the snapshot's, so a crash at any point leaves either the old snapshot with its whole journal or the new
+     * snapshot, even if both have the same board. A move cut off partway is ignored.
+     *
+     * MoveJournal makes each recorded move on its own copy of the game, so it never needs the whole Grid or MoveHistory again
+     * and a move costs the same however long the game is. If a MoveHistory is given, snapshots include it (see GridHelp::save),
+     * so undo and redo survive a reload.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class MoveJournal
+    {
+        public:
+            /* Setup */
+            MoveJournal(const std::string &newSaveFile, const Grid &grid, const MoveHistory *history = nullptr,
+                        const std::size_t newCompactInterval = COMPACT_INTERVAL);
+            ~MoveJournal();
+
+            MoveJournal(const MoveJournal &other) = delete;
+            MoveJournal &operator=(const MoveJournal &other) = delete;
+
+
+            /* Saving */
+            void record(const std::uint8_t move);
+            void record(const std::uint8_t *moves, const std::size_t count);
+            void compact();
+            void close();
+
+            ///Gets the save file (the snapshot)
+            const std::string &getSaveFile() const {return saveFile;}
+            ///Gets how many moves are in the journal and not yet in the snapshot
+            std::size_t getJournalMoves() const {return journalMoves;}
+
+
+            /* Loading */
+            static void load(const std::string &saveFile, Grid &grid);
+            static void load(const std::string &saveFile, Grid &grid, MoveHistory &history);
+            static void discard(const std::string &saveFile);
+            static std::string journalFile(const std::string &saveFile);
+
+
+            static constexpr std::size_t COMPACT_INTERVAL {256};///<How many moves are journaled before the snapshot is rewritten by default
+            static constexpr std::uint8_t UNDO {0x80};          ///<The move recorded for MoveHistory::undo
+            static constexpr std::uint8_t REDO {0x81};          ///<The move recorded for MoveHistory::redo
+
+        private:
+            std::string saveFile {};            ///<The save file (the snapshot)
+            std::size_t compactInterval {0};    ///<How many moves are journaled before MoveJournal::compact is called
+            std::size_t journalMoves {0};       ///<How many moves are in the journal
+            std::uint64_t generation {0};       ///<The generation of the snapshot; never 0, which is left for save files without one
+            std::FILE *journal {nullptr};       ///<The open, unbuffered journal
+            Grid latest {};                     ///<The Grid after the last move, kept up to date by MoveJournal::record, for MoveJournal::compact
+            MoveHistory latestHistory {};       ///<The MoveHistory after the last move, kept up to date by MoveJournal::record, for MoveJournal::compact
+            bool hasHistory {false};            ///<Whether a MoveHistory was given, so snapshots include MoveJournal::latestHistory
+
+            static bool apply(const std::uint8_t move, Grid &grid, MoveHistory &history);
+            static std::uint64_t snapshotGeneration(const std::string &saveFile);
+            static std::uint64_t journalGeneration(const std::string &saveFile);
+    };
+}
+#endif //MOVEJOURNAL_H
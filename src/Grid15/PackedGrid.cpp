@@ -0,0 +1,194 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/PackedGrid.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+
+#include <cstdint>
+#include <array>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    /* Setup */
+    ///Creates a new PackedGrid set to Grid::GOAL_GRID
+    PackedGrid::PackedGrid() {}
+
+    /** \brief Creates a new PackedGrid from a Grid (the index is not needed)
+     *
+     * \param grid The Grid to pack
+     * \throw std::invalid_argument If the grid array is not valid
+     */
+    PackedGrid::PackedGrid(const Grid &grid) : PackedGrid {grid.gridArray} {}
+
+    /** \brief Creates a new PackedGrid from a grid array
+     *
+     * \param gridArray The grid array to pack
+     * \throw std::invalid_argument If the grid array is not valid
+     */
+    PackedGrid::PackedGrid(const Grid::gridArray_t &gridArray)
+    {
+        if (GridHelp::validGridArray(gridArray))
+        {
+            tiles = {0};
+
+            for (std::uint_fast32_t y {0}; y < 4; ++y)
+            {
+                for (std::uint_fast32_t x {0}; x < 4; ++x)
+                {
+                    const std::uint_fast32_t cell {(y * 4) + x};
+
+                    tiles |= tiles_t {gridArray[y][x]} << (4 * cell);
+
+                    if (gridArray[y][x] == Grid::NO_TILE)
+                        blank = static_cast<std::uint8_t> (cell);
+                }
+            }
+        }
+        else
+            throw std::invalid_argument {"Grid invalid!"};
+    }
+
+    /** \brief Creates a new PackedGrid from packed tiles, like the ones from PackedGrid::getTiles
+     *
+     * \param newTiles The packed tiles
+     * \throw std::invalid_argument If the tiles do not have every tile exactly once
+     */
+    PackedGrid::PackedGrid(const tiles_t newTiles) : tiles {newTiles}
+    {
+        std::uint_fast32_t seen {0};//a bit for each tile
+
+        for (std::uint_fast32_t cell {0}; cell < 16; ++cell)
+        {
+            const std::uint8_t tile {getTile(static_cast<std::uint8_t> (cell))};
+
+            seen |= 1u << tile;
+
+            if (tile == Grid::NO_TILE)
+                blank = static_cast<std::uint8_t> (cell);
+        }
+
+        if (seen != 0xFFFF)
+            throw std::invalid_argument {"Grid invalid!"};
+    }
+
+    /** \brief Unpacks to a Grid, with a matching index
+     *
+     * \return The Grid
+     */
+    Grid PackedGrid::toGrid() const
+    {
+        Grid grid {toGridArray()};
+
+        for (std::uint_fast32_t cell {0}; cell < 16; ++cell)
+        {
+            const std::uint8_t tile {getTile(static_cast<std::uint8_t> (cell))};
+
+            grid.index[tile][0] = static_cast<std::uint8_t> (cell / 4);
+            grid.index[tile][1] = static_cast<std::uint8_t> (cell % 4);
+        }
+
+        return grid;
+    }
+
+    /** \brief Unpacks to a grid array
+     *
+     * \return The grid array
+     */
+    Grid::gridArray_t PackedGrid::toGridArray() const
+    {
+        Grid::gridArray_t gridArray {};
+
+        for (std::uint_fast32_t cell {0}; cell < 16; ++cell)
+            gridArray[cell / 4][cell % 4] = {getTile(static_cast<std::uint8_t> (cell))};
+
+        return gridArray;
+    }
+
+
+    /* Access */
+    /** \brief Finds the cell a tile is on
+     *
+     * \param tileNum The tile to find
+     * \return The cell (cell == (y * 4) + x)
+     * \throw std::invalid_argument If the tile is invalid
+     */
+    std::uint8_t PackedGrid::find(const std::uint8_t tileNum) const
+    {
+        if (tileNum > Grid::TILE_MAX)
+            throw std::invalid_argument {"tileNum invalid!"};
+
+        if (tileNum == Grid::NO_TILE)
+            return blank;
+
+        //a nibble equal to tileNum becomes 0 after the xor; the usual "has zero byte" trick, done per nibble, then finds it
+        const tiles_t spread {tiles ^ (0x1111111111111111 * tileNum)};
+        const tiles_t zeroes {(spread - 0x1111111111111111) & ~spread & 0x8888888888888888};
+
+        std::uint8_t cell {0};
+        for (tiles_t bits {zeroes >> 3}; !(bits & 0x1); bits >>= 4)
+            ++cell;
+
+        return cell;
+    }
+
+
+    /* Moves */
+    /** \brief Swaps a tile with the no tile, like GridHelp::swapTile
+     *
+     * \param tileNum The tile to swap
+     * \throw std::invalid_argument The tile being moved is invalid or not next to the no tile
+     */
+    void PackedGrid::swapTile(const std::uint8_t tileNum)
+    {
+        if (tileNum == Grid::NO_TILE)
+            throw std::invalid_argument {"tileNum or Grid invalid!"};
+
+        const std::uint8_t cell {find(tileNum)};
+
+        if (cell + 4 == blank)
+            move(Direction::UP);
+        else if (cell == blank + 4)
+            move(Direction::DOWN);
+        else if ((cell + 1 == blank) && (cell / 4 == blank / 4))
+            move(Direction::LEFT);
+        else if ((cell == blank + 1) && (cell / 4 == blank / 4))
+            move(Direction::RIGHT);
+        else
+            throw std::invalid_argument {"tileNum or Grid invalid!"};//not a valid move
+    }
+
+    /** \brief Checks if the board is won
+     *
+     * \return If the board is equal to Grid::GOAL_GRID
+     */
+    bool PackedGrid::hasWon() const
+    {
+        return tiles == GOAL_TILES;
+    }
+}
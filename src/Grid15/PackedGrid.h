@@ -0,0 +1,133 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef PACKEDGRID_H
+#define PACKEDGRID_H
+
+
+#include "Grid15/Grid.h"
+
+#include <cstdint>
+#include <array>
+
+
+namespace Grid15
+{
+    /** \class PackedGrid
+     *
+     * \brief A compact board for searches and batches: 16 nibbles in one 64 bit integer, plus the no tile's cell
+     *
+     * Cell (y * 4) + x is kept in bits [4 * cell] to [(4 * cell) + 3], so a PackedGrid is 16 bytes instead of the 48 of a Grid,
+     * and a move is a shift and a couple of masks instead of rewriting the grid array and the index.
+     * The no tile's nibble is always 0, so moving a tile onto it never needs clearing first.
+     *
+     * Converts to and from a Grid without losing anything.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class PackedGrid
+    {
+        static_assert(Grid::basicGrid_t::layout_t::BITS == 4 && Grid::basicGrid_t::layout_t::WORDS == 1, "PackedGrid needs a board that packs into one std::uint64_t with 4 bits per tile");
+
+        public:
+            /* Typedefs */
+            typedef std::uint64_t tiles_t;///<The type used for the packed tiles
+
+            ///A direction for the no tile to move in (the tile it swaps with moves the other way)
+            enum class Direction : std::uint8_t {UP, DOWN, LEFT, RIGHT};
+
+
+            /* Setup */
+            PackedGrid();
+            explicit PackedGrid(const Grid &grid);
+            explicit PackedGrid(const Grid::gridArray_t &gridArray);
+            explicit PackedGrid(const tiles_t newTiles);
+
+            Grid toGrid() const;
+            Grid::gridArray_t toGridArray() const;
+
+
+            /* Access */
+            ///Gets the tile on a cell (cell == (y * 4) + x)
+            std::uint8_t getTile(const std::uint8_t cell) const {return static_cast<std::uint8_t> ((tiles >> (4 * cell)) & 0xF);}
+            ///Gets the tile at a y and x coordinate
+            std::uint8_t getTile(const std::uint8_t tileY, const std::uint8_t tileX) const {return getTile(static_cast<std::uint8_t> ((tileY * 4) + tileX));}
+            ///Gets the no tile's cell
+            std::uint8_t getBlank() const {return blank;}
+            ///Gets the packed tiles
+            tiles_t getTiles() const {return tiles;}
+
+            std::uint8_t find(const std::uint8_t tileNum) const;
+
+
+            /* Moves */
+            ///Checks if the no tile can move in a direction without leaving the board
+            bool canMove(const Direction direction) const
+            {
+                switch (direction)
+                {
+                    case Direction::UP:
+                        return blank >= 4;
+                    case Direction::DOWN:
+                        return blank < 12;
+                    case Direction::LEFT:
+                        return (blank % 4) != 0;
+                    default:
+                        return (blank % 4) != 3;
+                }
+            }
+
+            /** \brief Moves the no tile in a direction without checking anything; see PackedGrid::canMove
+             *
+             * Kept in the header so searches can keep the board in registers
+             *
+             * \param direction The direction to move the no tile in
+             */
+            void move(const Direction direction)
+            {
+                const std::uint8_t target {static_cast<std::uint8_t> (blank + OFFSETS[static_cast<std::size_t> (direction)])};
+                const tiles_t tile {(tiles >> (4 * target)) & 0xF};
+
+                tiles &= ~(tiles_t {0xF} << (4 * target));
+                tiles |= tile << (4 * blank);
+                blank = {target};
+            }
+
+            void swapTile(const std::uint8_t tileNum);
+            bool hasWon() const;
+
+
+            /* Comparison */
+            bool operator==(const PackedGrid &other) const {return tiles == other.tiles;}///<The no tile's cell follows from the tiles
+            bool operator!=(const PackedGrid &other) const {return tiles != other.tiles;}///<The no tile's cell follows from the tiles
+
+            static constexpr tiles_t GOAL_TILES {Grid::basicGrid_t::PACKED_GOAL[0]};///<The packed tiles of Grid::GOAL_GRID (0x0FEDCBA987654321)
+
+        private:
+            static constexpr std::array<std::int8_t, 4> OFFSETS {{-4, 4, -1, 1}};///<How far the no tile's cell changes for each Direction
+
+            tiles_t tiles {GOAL_TILES}; ///<The tiles, 4 bits each
+            std::uint8_t blank {15};    ///<The no tile's cell
+    };
+}
+#endif //PACKEDGRID_H
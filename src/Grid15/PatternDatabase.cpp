@@ -0,0 +1,963 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/PatternDatabase.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/Rank.h"
+#include "Grid15/MappedFile.h"
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+
+
+namespace Grid15
+{
+    namespace
+    {
+        constexpr std::uint_fast32_t CELLS      {16};       ///<The number of cells on the board
+        constexpr std::uint8_t NOT_FOUND        {0xFF};     ///<Table value for placements not reached (yet) by PatternDatabase::build
+
+        constexpr char FILE_MAGIC[8]            {"15SLPDB"};///<The first bytes of a pattern database file
+        constexpr std::uint32_t BYTE_ORDER_MARK {0x01020304};///<Written as is, so files from computers with another byte order are noticed
+
+        /** \brief The start of a pattern database file
+         */
+        struct FileHeader
+        {
+            char magic[8];                  ///<Always FILE_MAGIC
+            std::uint32_t version;          ///<Always PatternDatabase::FILE_VERSION
+            std::uint32_t byteOrder;        ///<Always BYTE_ORDER_MARK
+            std::uint32_t patternCount;     ///<How many FileTable come after the header
+            std::uint32_t reserved;         ///<Padding; 0
+        };
+
+        /** \brief The description of one table in a pattern database file
+         */
+        struct FileTable
+        {
+            std::uint8_t tiles[PatternDatabase::PATTERN_MAX];  ///<The tiles in the pattern
+            std::uint32_t tileCount;        ///<How many of FileTable::tiles are used
+            std::uint32_t encoding;         ///<The PatternDatabase::Encoding of the table (always 0, PatternDatabase::Encoding::BYTE, in version 1 files)
+            std::uint64_t offset;           ///<Where the table starts, from the start of the file
+            std::uint64_t size;             ///<How many bytes the table is
+            std::uint64_t checksum;         ///<The checksum of the table's bytes
+        };
+
+        static_assert(sizeof(FileHeader) == 24 && sizeof(FileTable) == 40, "Pattern database file structures must not have extra padding");
+
+        ///Manhattan distance of [tile] on [cell] from its goal cell
+        constexpr std::array<std::array<std::uint8_t, CELLS>, CELLS> DISTANCES
+        {
+            []() constexpr
+            {
+                std::array<std::array<std::uint8_t, CELLS>, CELLS> distances {};
+
+                for (std::uint_fast32_t tile {1}; tile < CELLS; ++tile)
+                    for (std::uint_fast32_t cell {0}; cell < CELLS; ++cell)
+                    {
+                        const std::uint_fast32_t goalY {(tile - 1) / 4}, goalX {(tile - 1) % 4};
+                        const std::uint_fast32_t y {cell / 4}, x {cell % 4};
+
+                        distances[tile][cell] = static_cast<std::uint8_t> ((y > goalY ? y - goalY : goalY - y) + (x > goalX ? x - goalX : goalX - x));
+                    }
+
+                return distances;
+            }()
+        };
+
+        ///How much a PatternDatabase::Encoding::MOD_THREE value changed, indexed by (new value - old value) mod 3
+        constexpr std::int_fast32_t MOD_THREE_STEPS[3] {0, 1, -1};
+
+        /** \brief Rounds a file offset up to the next page
+         *
+         * \param offset The offset
+         * \return The offset of the next 4 KiB page, or the offset if it is already at the start of one
+         */
+        constexpr std::uint64_t pageAlign(const std::uint64_t offset)
+        {
+            return (offset + 4095) & ~static_cast<std::uint64_t> (4095);
+        }
+
+        /** \brief A check that is already done, for pattern databases that were built instead of opened
+         *
+         * \return A ready std::shared_future holding true
+         */
+        std::shared_future<bool> readyCheck()
+        {
+            std::promise<bool> valid {};
+            valid.set_value(true);
+
+            return valid.get_future().share();
+        }
+
+        /** \brief Finds the cells next to a cell
+         *
+         * \param cell The cell
+         * \return A bitmask of the cells next to it
+         */
+        constexpr std::uint_fast32_t neighbourMask(const std::uint_fast32_t cell)
+        {
+            const std::uint_fast32_t y {cell / 4}, x {cell % 4};
+            std::uint_fast32_t mask {0};
+
+            if (y > 0)
+                mask |= 1u << (cell - 4);
+            if (y < 3)
+                mask |= 1u << (cell + 4);
+            if (x > 0)
+                mask |= 1u << (cell - 1);
+            if (x < 3)
+                mask |= 1u << (cell + 1);
+
+            return mask;
+        }
+
+        /** \brief Finds every cell the no tile can reach without moving a pattern tile
+         *
+         * \param start The cell of the no tile
+         * \param freeCells A bitmask of the cells not covered by pattern tiles
+         * \return A bitmask of the reachable cells
+         */
+        std::uint_fast32_t floodFill(const std::uint_fast32_t start, const std::uint_fast32_t freeCells)
+        {
+            std::uint_fast32_t region {1u << start};
+            std::uint_fast32_t previous {0};
+
+            while (region != previous)
+            {
+                previous = {region};
+                region |= ((region << 4) | (region >> 4) | ((region << 1) & 0xEEEE) | ((region >> 1) & 0x7777)) & freeCells;
+            }
+
+            return region;
+        }
+    }
+
+    /* Setup */
+    /** \brief Builds the pattern databases for a ready made partition
+     *
+     * \param partition The partition to use (7-8 by default)
+     */
+    PatternDatabase::PatternDatabase(const Partition partition) : PatternDatabase(getPartition(partition)) {}
+
+    /** \brief Builds the pattern databases for a custom partition
+     *
+     * \param newPatterns The tiles in each pattern; they must not share any tiles, and each can have up to PatternDatabase::PATTERN_MAX tiles
+     * \throw std::invalid_argument If a pattern is empty, too big, or has tiles that are invalid or in another pattern
+     */
+    PatternDatabase::PatternDatabase(const std::vector<pattern_t> &newPatterns)
+    {
+        setPatterns(newPatterns);
+
+        //all of the tables share one block of memory
+        std::size_t totalSize {0};
+        for (const pattern_t &pattern : patterns)
+            totalSize += tableSize(pattern.size());
+
+        std::shared_ptr<std::uint8_t> memory {new std::uint8_t [totalSize], std::default_delete<std::uint8_t[]> {}};
+
+        tables.clear();
+        for (std::size_t i {0}, offset {0}; i < patterns.size(); offset += tableSize(patterns[i].size()), ++i)
+        {
+            build(i, memory.get() + offset);
+            tables.push_back(memory.get() + offset);
+        }
+
+        storage = {memory};
+        checksumsValid = {readyCheck()};
+    }
+
+    /** \brief Opens pattern databases saved with PatternDatabase::save
+     *
+     * The file is memory mapped (read only and shared) instead of read, so opening is instant no matter how big the tables are,
+     * pages are only read from disk as lookups touch them, and every process using the same file shares the same memory.
+     * Only the header is checked here; the tables' checksums are checked on a background thread that starts now, so lookups can start
+     * right away. PatternDatabase::verify waits for it, which Solver::solve does before giving back a solution, so a corrupted or cut
+     * off file never gives a result that is not optimal.
+     *
+     * \param file The file to open
+     * \throw std::ios_base::failure If the file cannot be opened or mapped
+     * \throw std::invalid_argument If the file is not a pattern database file, is from another version, or its header is corrupted
+     */
+    PatternDatabase::PatternDatabase(const std::string &file)
+    {
+        std::size_t fileSize {0};
+        storage = {MappedFile::map(file, fileSize, MappedFile::Access::RANDOM)};//lookups jump all over the tables, so reading ahead only wastes time and memory
+
+        const std::uint8_t *data {static_cast<const std::uint8_t *> (storage.get())};
+
+        //check the header
+        if (fileSize < sizeof(FileHeader))
+            throw std::invalid_argument {"Pattern database file invalid!"};
+
+        FileHeader header {};
+        std::memcpy(&header, data, sizeof(FileHeader));
+
+        if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK)
+            throw std::invalid_argument {"Pattern database file invalid!"};
+        if (header.version != 1 && header.version != FILE_VERSION)//version 1 files are the same, but always byte encoded
+            throw std::invalid_argument {"Pattern database file version unsupported!"};
+        if (header.patternCount == 0 || header.patternCount > Grid::TILE_MAX || fileSize < sizeof(FileHeader) + (header.patternCount * sizeof(FileTable)))
+            throw std::invalid_argument {"Pattern database file invalid!"};
+
+        //read the table descriptions
+        std::vector<FileTable> fileTables(header.patternCount);
+        std::memcpy(fileTables.data(), data + sizeof(FileHeader), fileTables.size() * sizeof(FileTable));
+
+        std::vector<pattern_t> newPatterns {};
+        for (const FileTable &fileTable : fileTables)
+        {
+            if (fileTable.tileCount > PATTERN_MAX)
+                throw std::invalid_argument {"Pattern database file invalid!"};
+
+            newPatterns.emplace_back(fileTable.tiles, fileTable.tiles + fileTable.tileCount);
+        }
+
+        setPatterns(newPatterns);//throws if the patterns are corrupted
+
+        encoding = static_cast<Encoding> (fileTables.front().encoding);
+        if (encoding > Encoding::MIN_FOLDED || (header.version == 1 && encoding != Encoding::BYTE))
+            throw std::invalid_argument {"Pattern database file invalid!"};
+
+        tables.clear();
+        for (std::size_t i {0}; i < fileTables.size(); ++i)
+        {
+            if (fileTables[i].encoding != fileTables.front().encoding || fileTables[i].size != encodedSize(patterns[i].size(), encoding))
+                throw std::invalid_argument {"Pattern database file invalid!"};
+            if (fileTables[i].offset > fileSize || fileTables[i].size > fileSize - fileTables[i].offset)
+                throw std::invalid_argument {"Pattern database file invalid!"};
+
+            tables.push_back(data + fileTables[i].offset);
+        }
+
+        //check the tables in the background, so opening stays instant; the check keeps its own copy of the mapping
+        checksumsValid = std::async(std::launch::async, [fileTables, data, mapping = storage]
+        {
+            bool valid {true};
+
+            for (const FileTable &fileTable : fileTables)
+            {
+                //read ahead for the check, then go back to random access for the lookups
+                MappedFile::advise(data + fileTable.offset, fileTable.size, MappedFile::Access::SEQUENTIAL);
+                valid = {valid && MappedFile::checksum(data + fileTable.offset, fileTable.size) == fileTable.checksum};
+                MappedFile::advise(data + fileTable.offset, fileTable.size, MappedFile::Access::RANDOM);
+            }
+
+            return valid;
+        }).share();
+    }
+
+    /** \brief Makes a copy of byte encoded pattern databases with the tables stored another way
+     *
+     * \param source The pattern databases to copy; must use PatternDatabase::Encoding::BYTE
+     * \param newEncoding How to store the new tables
+     * \throw std::invalid_argument If the source is not byte encoded
+     */
+    PatternDatabase::PatternDatabase(const PatternDatabase &source, const Encoding newEncoding)
+    {
+        if (source.encoding != Encoding::BYTE)
+            throw std::invalid_argument {"Pattern database must be byte encoded!"};
+
+        setPatterns(source.patterns);
+        encoding = {newEncoding};
+
+        std::size_t totalSize {0};
+        for (const pattern_t &pattern : patterns)
+            totalSize += encodedSize(pattern.size(), encoding);
+
+        std::shared_ptr<std::uint8_t> memory {new std::uint8_t [totalSize], std::default_delete<std::uint8_t[]> {}};
+
+        tables.clear();
+        for (std::size_t i {0}, offset {0}; i < patterns.size(); offset += encodedSize(patterns[i].size(), encoding), ++i)
+        {
+            encode(i, source.tables[i], memory.get() + offset);
+            tables.push_back(memory.get() + offset);
+        }
+
+        storage = {memory};
+        checksumsValid = {readyCheck()};
+    }
+
+    /** \brief Checks that the patterns are valid and uses them
+     *
+     * \param newPatterns The tiles in each pattern
+     * \throw std::invalid_argument If a pattern is empty, too big, or has tiles that are invalid or in another pattern
+     */
+    void PatternDatabase::setPatterns(const std::vector<pattern_t> &newPatterns)
+    {
+        std::array<std::uint8_t, 16> newTilePatterns {};
+        newTilePatterns.fill(NO_PATTERN);
+
+        for (std::size_t i {0}; i < newPatterns.size(); ++i)
+        {
+            if (newPatterns[i].empty() || newPatterns[i].size() > PATTERN_MAX)
+                throw std::invalid_argument {"Pattern size invalid!"};
+
+            for (const std::uint8_t tile : newPatterns[i])
+            {
+                if (tile == Grid::NO_TILE || tile > Grid::TILE_MAX || newTilePatterns[tile] != NO_PATTERN)
+                    throw std::invalid_argument {"Pattern tiles invalid!"};
+
+                newTilePatterns[tile] = static_cast<std::uint8_t> (i);
+            }
+        }
+
+        patterns = newPatterns;
+        tilePatterns = {newTilePatterns};
+    }
+
+    /** \brief Gets the tiles of each pattern in a ready made partition
+     *
+     * \param partition The partition
+     * \return The patterns
+     */
+    std::vector<PatternDatabase::pattern_t> PatternDatabase::getPartition(const Partition partition)
+    {
+        switch (partition)
+        {
+            case Partition::FIVE_FIVE_FIVE:
+                return {{1, 2, 3, 5, 6}, {4, 7, 8, 11, 12}, {9, 10, 13, 14, 15}};
+            case Partition::SIX_SIX_THREE:
+                return {{1, 5, 6, 9, 10, 13}, {7, 8, 11, 12, 14, 15}, {2, 3, 4}};
+            case Partition::SEVEN_EIGHT:
+            default:
+                return {{1, 5, 6, 9, 10, 13, 14}, {2, 3, 4, 7, 8, 11, 12, 15}};
+        }
+    }
+
+    /** \brief Fills in the table of one pattern with a breadth first search backwards from Grid::GOAL_GRID
+     *
+     * States are the cells of the pattern tiles plus the region of cells the no tile can wander around in for free.
+     * Each region is stored by its lowest cell, so every move in the search costs exactly one pattern tile move.
+     * The table keeps the cheapest region for each placement.
+     *
+     * There is no list of states to expand, which grows to gigabytes for 8 tiles. Instead each placement has a bitmask of the regions
+     * reached so far, and each depth is a scan over the placements flagged by the depth before. Every move changes the colour (checkerboard
+     * style) of one pattern tile's cell, so placements from one depth are never reached again at the next; a scan only reads placements
+     * no other thread is writing, and the scan can be split between threads. Expanding a placement expands every region it has, including
+     * ones from earlier depths, but everything those reach is already marked, so the search stays breadth first.
+     *
+     * \param pattern The pattern to build
+     * \param table Where to put the table; must have room for PatternDatabase::tableSize entries
+     */
+    void PatternDatabase::build(const std::size_t pattern, std::uint8_t *table)
+    {
+        const std::size_t count {patterns[pattern].size()};
+        const std::size_t size {tableSize(count)};
+        const std::size_t words {(size + 63) / 64};
+
+        std::fill(table, table + size, NOT_FOUND);
+        std::vector<std::atomic<std::uint16_t>> regions(size);//bit c is set if the region with lowest cell c has been reached
+        std::vector<std::atomic<std::uint64_t>> current(words), next(words);//bit rank % 64 of word rank / 64 is set if the placement needs expanding
+
+        //start from the goal, with the no tile on the last cell
+        std::array<std::uint8_t, PATTERN_MAX> goalCells {};
+        std::uint_fast32_t goalPatternCells {0};
+
+        for (std::size_t i {0}; i < count; ++i)
+        {
+            goalCells[i] = static_cast<std::uint8_t> (patterns[pattern][i] - 1);
+            goalPatternCells |= 1u << goalCells[i];
+        }
+
+        const std::size_t goalRank {static_cast<std::size_t> (Rank::rankLexicographic(goalCells.data(), count))};
+        const std::uint_fast32_t goalRegion {floodFill(CELLS - 1, ~goalPatternCells & 0xFFFF)};
+
+        regions[goalRank] = static_cast<std::uint16_t> (goalRegion & (~goalRegion + 1));//just the lowest cell
+        current[goalRank / 64] = static_cast<std::uint64_t> (1) << (goalRank % 64);
+
+        //expands the flagged placements in words [first, last) of current
+        auto expand = [&](const std::uint8_t depth, const std::size_t first, const std::size_t last, std::atomic<bool> &found)
+        {
+            std::array<std::uint8_t, PATTERN_MAX> cells {};
+
+            for (std::size_t word {first}; word < last; ++word)
+            {
+                std::uint64_t flags {current[word].load(std::memory_order_relaxed)};
+                current[word].store(0, std::memory_order_relaxed);
+
+                while (flags)
+                {
+                    const std::size_t rank {(word * 64) + static_cast<std::size_t> (__builtin_ctzll(flags))};
+                    flags &= flags - 1;
+
+                    if (table[rank] == NOT_FOUND)//breadth first, so the first depth to flag it is the cheapest
+                        table[rank] = {depth};
+
+                    Rank::unrankLexicographic(rank, cells.data(), count);
+
+                    std::uint_fast32_t patternCells {0};
+                    for (std::size_t i {0}; i < count; ++i)
+                        patternCells |= 1u << cells[i];
+
+                    const std::uint_fast32_t freeCells {~patternCells & 0xFFFF};
+                    std::uint_fast32_t starts {regions[rank].load(std::memory_order_relaxed)};
+
+                    while (starts)
+                    {
+                        const std::uint_fast32_t region {floodFill(static_cast<std::uint_fast32_t> (__builtin_ctz(starts)), freeCells)};
+                        starts &= ~region;
+
+                        //slide each pattern tile into each reachable cell next to it
+                        for (std::size_t i {0}; i < count; ++i)
+                        {
+                            const std::uint8_t from {cells[i]};
+                            std::uint_fast32_t targets {neighbourMask(from) & region};
+
+                            while (targets)
+                            {
+                                const std::uint8_t to {static_cast<std::uint8_t> (__builtin_ctz(targets))};
+                                targets &= targets - 1;
+
+                                //the no tile ends up where the tile was
+                                cells[i] = {to};
+                                const std::uint_fast32_t newRegion {floodFill(from, (freeCells & ~(1u << to)) | (1u << from))};
+                                const std::size_t newRank {static_cast<std::size_t> (Rank::rankLexicographic(cells.data(), count))};
+                                const std::uint16_t newStart {static_cast<std::uint16_t> (newRegion & (~newRegion + 1))};
+                                cells[i] = {from};
+
+                                if (!(regions[newRank].fetch_or(newStart, std::memory_order_relaxed) & newStart))
+                                {
+                                    next[newRank / 64].fetch_or(static_cast<std::uint64_t> (1) << (newRank % 64), std::memory_order_relaxed);
+                                    found.store(true, std::memory_order_relaxed);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        const std::size_t threads {std::max<std::size_t> (std::min<std::size_t> (std::thread::hardware_concurrency(), words), 1)};
+
+        for (std::uint8_t depth {0}; ; ++depth)
+        {
+            std::atomic<bool> found {false};
+            std::vector<std::thread> workers {};
+
+            for (std::size_t i {1}; i < threads; ++i)
+                workers.emplace_back(expand, depth, (words * i) / threads, (words * (i + 1)) / threads, std::ref(found));
+
+            expand(depth, 0, words / threads, found);
+
+            for (std::thread &worker : workers)
+                worker.join();
+
+            if (!found)
+                break;
+
+            current.swap(next);
+        }
+    }
+
+
+    /** \brief Stores a byte encoded table with PatternDatabase::encoding
+     *
+     * \param pattern The pattern of the table
+     * \param source The byte encoded table
+     * \param table Where to put the new table; must have room for PatternDatabase::encodedSize bytes
+     */
+    void PatternDatabase::encode(const std::size_t pattern, const std::uint8_t *source, std::uint8_t *table) const
+    {
+        const std::size_t count {patterns[pattern].size()};
+        const std::size_t size {tableSize(count)};
+
+        std::fill(table, table + encodedSize(count, encoding), 0);
+
+        switch (encoding)
+        {
+            case Encoding::BYTE:
+            {
+                std::copy(source, source + size, table);
+                break;
+            }
+            case Encoding::NIBBLE:
+            {
+                //a pattern needs at least its Manhattan distance, and always an even number more, so only the extra pairs of moves are stored
+                std::array<std::uint8_t, PATTERN_MAX> cells {};
+
+                for (std::size_t rank {0}; rank < size; ++rank)
+                {
+                    Rank::unrankLexicographic(rank, cells.data(), count);
+
+                    std::uint_fast32_t distance {0};
+                    for (std::size_t i {0}; i < count; ++i)
+                        distance += DISTANCES[patterns[pattern][i]][cells[i]];
+
+                    const std::uint_fast32_t extra {std::min<std::uint_fast32_t> ((source[rank] - distance) / 2, 15)};//capping only ever underestimates
+                    table[rank / 2] |= static_cast<std::uint8_t> (extra << ((rank % 2) * 4));
+                }
+                break;
+            }
+            case Encoding::MOD_THREE:
+            {
+                std::vector<std::uint8_t> values(source, source + size);
+                smooth(pattern, values);
+
+                for (std::size_t rank {0}; rank < size; ++rank)
+                    table[rank / 4] |= static_cast<std::uint8_t> ((values[rank] % 3) << ((rank % 4) * 2));
+                break;
+            }
+            case Encoding::MIN_FOLDED:
+            {
+                //neighbouring ranks only differ by where the last tile is, so their values are usually close
+                for (std::size_t rank {0}; rank < size; rank += 4)
+                    table[rank / 4] = {*std::min_element(source + rank, source + std::min(rank + 4, size))};
+                break;
+            }
+        }
+    }
+
+    /** \brief Lowers table values until no move of a pattern tile changes one by more than 1
+     *
+     * PatternDatabase::Encoding::MOD_THREE needs this to recover values from the value before a move.
+     * The byte tables are not quite like that, because the region the no tile ends up in after a move matters to them.
+     * Lowered values never drop below what the pattern would need if the no tile could be anywhere, so they stay admissible.
+     *
+     * \param pattern The pattern of the table
+     * \param values The byte encoded table to change
+     */
+    void PatternDatabase::smooth(const std::size_t pattern, std::vector<std::uint8_t> &values) const
+    {
+        const std::size_t count {patterns[pattern].size()};
+        std::array<std::uint8_t, PATTERN_MAX> cells {};
+
+        for (bool changed {true}; changed;)
+        {
+            changed = {false};
+
+            for (std::size_t rank {0}; rank < values.size(); ++rank)
+            {
+                Rank::unrankLexicographic(rank, cells.data(), count);
+
+                std::uint_fast32_t patternCells {0};
+                for (std::size_t i {0}; i < count; ++i)
+                    patternCells |= 1u << cells[i];
+
+                for (std::size_t i {0}; i < count; ++i)
+                {
+                    const std::uint8_t from {cells[i]};
+                    std::uint_fast32_t targets {neighbourMask(from) & ~patternCells};
+
+                    while (targets)
+                    {
+                        cells[i] = static_cast<std::uint8_t> (__builtin_ctz(targets));
+                        targets &= targets - 1;
+
+                        const std::size_t other {static_cast<std::size_t> (Rank::rankLexicographic(cells.data(), count))};
+
+                        if (values[other] > values[rank] + 1)
+                        {
+                            values[other] = static_cast<std::uint8_t> (values[rank] + 1);
+                            changed = {true};
+                        }
+                        else if (values[rank] > values[other] + 1)
+                        {
+                            values[rank] = static_cast<std::uint8_t> (values[other] + 1);
+                            changed = {true};
+                        }
+                    }
+
+                    cells[i] = {from};
+                }
+            }
+        }
+    }
+
+    /** \brief Finds the exact value of a PatternDatabase::Encoding::MOD_THREE pattern without knowing the value before
+     *
+     * Walks the pattern tiles back to their goal cells, always to a placement whose value is one less, and counts the steps
+     *
+     * \param pattern The pattern
+     * \param cells The cell of each tile
+     * \return The value
+     * \throw std::invalid_argument If the table is corrupted and no way back is found
+     */
+    std::uint_fast32_t PatternDatabase::descend(const std::size_t pattern, cells_t cells) const
+    {
+        const pattern_t &tiles {patterns[pattern]};
+        std::uint_fast32_t residue {lookup(pattern, rank(pattern, cells))};
+        std::uint_fast32_t value {0};
+
+        while (true)
+        {
+            std::uint_fast32_t patternCells {0};
+            bool atGoal {true};
+
+            for (const std::uint8_t tile : tiles)
+            {
+                patternCells |= 1u << cells[tile];
+                atGoal = {atGoal && (cells[tile] == tile - 1)};
+            }
+
+            if (atGoal)
+                return value;
+
+            //find a move one step closer; one always exists
+            bool moved {false};
+
+            for (std::size_t i {0}; i < tiles.size() && !moved; ++i)
+            {
+                const std::uint8_t from {cells[tiles[i]]};
+                std::uint_fast32_t targets {neighbourMask(from) & ~patternCells};
+
+                while (targets && !moved)
+                {
+                    cells[tiles[i]] = static_cast<std::uint8_t> (__builtin_ctz(targets));
+                    targets &= targets - 1;
+
+                    const std::uint_fast32_t newResidue {lookup(pattern, rank(pattern, cells))};
+
+                    if (newResidue == (residue + 2) % 3)
+                    {
+                        residue = {newResidue};
+                        moved = {true};
+                    }
+                    else
+                        cells[tiles[i]] = {from};
+                }
+            }
+
+            if (!moved || ++value > 255)
+                throw std::invalid_argument {"Pattern database corrupted!"};
+        }
+    }
+
+
+    /* Storage */
+    /** \brief Saves the pattern databases to a file that can be opened (and memory mapped) later
+     *
+     * The file has a versioned header, then a description and checksum of each table, then each table starting on its own page.
+     * Numbers are stored in the byte order of the computer that saved the file.
+     *
+     * \param file The file to save to
+     * \throw std::ios_base::failure From std::ofstream; if a file operation goes wrong
+     */
+    void PatternDatabase::save(const std::string &file) const
+    {
+        FileHeader header {};
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = {FILE_VERSION};
+        header.byteOrder = {BYTE_ORDER_MARK};
+        header.patternCount = static_cast<std::uint32_t> (patterns.size());
+
+        std::vector<FileTable> fileTables(patterns.size());
+        std::uint64_t offset {pageAlign(sizeof(FileHeader) + (fileTables.size() * sizeof(FileTable)))};
+
+        for (std::size_t i {0}; i < patterns.size(); ++i)
+        {
+            std::copy(std::begin(patterns[i]), std::end(patterns[i]), std::begin(fileTables[i].tiles));
+            fileTables[i].tileCount = static_cast<std::uint32_t> (patterns[i].size());
+            fileTables[i].encoding = static_cast<std::uint32_t> (encoding);
+            fileTables[i].offset = {offset};
+            fileTables[i].size = {encodedSize(patterns[i].size(), encoding)};
+            fileTables[i].checksum = {MappedFile::checksum(tables[i], fileTables[i].size)};
+
+            offset = {pageAlign(offset + fileTables[i].size)};
+        }
+
+        std::ofstream fileStream {};
+        fileStream.exceptions(fileStream.failbit | fileStream.badbit);//to throw exceptions if something goes wrong
+        fileStream.open(file, std::ios::binary | std::ios::trunc);
+
+        fileStream.write(reinterpret_cast<const char *> (&header), sizeof(FileHeader));
+        fileStream.write(reinterpret_cast<const char *> (fileTables.data()), fileTables.size() * sizeof(FileTable));
+
+        for (std::size_t i {0}; i < patterns.size(); ++i)
+        {
+            //pad up to the start of the table
+            const std::uint64_t position {static_cast<std::uint64_t> (fileStream.tellp())};
+            const std::vector<char> padding(fileTables[i].offset - position, 0);
+            fileStream.write(padding.data(), padding.size());
+
+            fileStream.write(reinterpret_cast<const char *> (tables[i]), fileTables[i].size);
+        }
+
+        fileStream.close();
+    }
+
+    /** \brief Checks the tables against the checksums in the file they were opened from
+     *
+     * Waits for the check started when the file was opened, which reads every table once; the result is remembered after that.
+     * Pattern databases that were built instead of opened are always valid. Safe to call from several threads at once.
+     *
+     * \return If every table matches its checksum
+     */
+    bool PatternDatabase::verify() const
+    {
+        const std::shared_future<bool> check {checksumsValid};//each thread waits on its own copy, so solvers sharing the tables can all call this
+        return check.get();
+    }
+
+
+    /* Lookups */
+    /** \brief Finds the sum of all of the patterns' values for a Grid
+     *
+     * \param grid The Grid to use
+     * \return An admissible estimate of the moves left to solve the Grid
+     * \throw std::invalid_argument If the Grid is not valid (index and/or grid array)
+     */
+    std::uint_fast32_t PatternDatabase::estimate(const Grid &grid) const
+    {
+        if (GridHelp::validGrid(grid))
+        {
+            cells_t cells {};
+
+            for (std::uint_fast32_t tile {0}; tile < CELLS; ++tile)
+                cells[tile] = static_cast<std::uint8_t> ((grid.index[tile][0] * 4) + grid.index[tile][1]);
+
+            return estimate(cells);
+        }
+        else
+            throw std::invalid_argument {"Grid invalid!"};
+    }
+
+    /** \brief Finds the sum of all of the patterns' values
+     *
+     * \param cells The cell of each tile
+     * \return An admissible estimate of the moves left
+     */
+    std::uint_fast32_t PatternDatabase::estimate(const cells_t &cells) const
+    {
+        std::uint_fast32_t sum {0};
+
+        for (std::size_t i {0}; i < patterns.size(); ++i)
+            sum += estimate(i, cells);
+
+        return sum;
+    }
+
+    /** \brief Finds the value of one pattern
+     *
+     * With PatternDatabase::Encoding::MOD_THREE this has to walk the pattern back to its goal; inside a search use the version that takes the value before the move.
+     *
+     * \param pattern The pattern
+     * \param cells The cell of each tile
+     * \return The fewest moves of the pattern's tiles needed to put them all back (or a bit less, depending on the encoding)
+     */
+    std::uint_fast32_t PatternDatabase::estimate(const std::size_t pattern, const cells_t &cells) const
+    {
+        switch (encoding)
+        {
+            case Encoding::BYTE:
+            case Encoding::MIN_FOLDED:
+                return lookup(pattern, rank(pattern, cells));
+            case Encoding::NIBBLE:
+            {
+                std::uint_fast32_t distance {0};
+                for (const std::uint8_t tile : patterns[pattern])
+                    distance += DISTANCES[tile][cells[tile]];
+
+                return distance + (2 * lookup(pattern, rank(pattern, cells)));
+            }
+            case Encoding::MOD_THREE:
+            default:
+                return descend(pattern, cells);
+        }
+    }
+
+    /** \brief Finds the value of one pattern after a move, knowing its value before
+     *
+     * This is the fast way to use PatternDatabase::Encoding::MOD_THREE: a move changes a value by at most one, so the value mod 3 is enough to tell which way.
+     * The other encodings ignore the previous value.
+     *
+     * \param pattern The pattern
+     * \param cells The cell of each tile, after the move
+     * \param previous The value of the pattern before the move (or after, to undo it)
+     * \return The fewest moves of the pattern's tiles needed to put them all back (or a bit less, depending on the encoding)
+     */
+    std::uint_fast32_t PatternDatabase::estimate(const std::size_t pattern, const cells_t &cells, const std::uint_fast32_t previous) const
+    {
+        if (encoding == Encoding::MOD_THREE)
+            return previous + MOD_THREE_STEPS[(lookup(pattern, rank(pattern, cells)) + 3 - (previous % 3)) % 3];
+        else
+            return estimate(pattern, cells);
+    }
+
+    /** \brief Ranks the placement of one pattern's tiles; the index into its table
+     *
+     * \param pattern The pattern
+     * \param cells The cell of each tile
+     * \return The rank
+     */
+    std::size_t PatternDatabase::rank(const std::size_t pattern, const cells_t &cells) const
+    {
+        std::array<std::uint8_t, PATTERN_MAX> patternCells {};
+
+        for (std::size_t i {0}; i < patterns[pattern].size(); ++i)
+            patternCells[i] = {cells[patterns[pattern][i]]};
+
+        return static_cast<std::size_t> (Rank::rankLexicographic(patternCells.data(), patterns[pattern].size()));
+    }
+
+    /** \brief Reads one stored entry of a pattern's table
+     *
+     * \param pattern The pattern
+     * \param rank The rank of the placement (see PatternDatabase::rank)
+     * \return The entry as stored; only the actual value with PatternDatabase::Encoding::BYTE (see PatternDatabase::Encoding for the others)
+     */
+    std::uint8_t PatternDatabase::lookup(const std::size_t pattern, const std::size_t rank) const
+    {
+        switch (encoding)
+        {
+            case Encoding::BYTE:
+                return tables[pattern][rank];
+            case Encoding::NIBBLE:
+                return (tables[pattern][rank / 2] >> ((rank % 2) * 4)) & 0xF;
+            case Encoding::MOD_THREE:
+                return (tables[pattern][rank / 4] >> ((rank % 4) * 2)) & 0x3;
+            case Encoding::MIN_FOLDED:
+            default:
+                return tables[pattern][rank / 4];
+        }
+    }
+
+    /** \brief Times lookups of random placements, the way a search would do them
+     *
+     * \param lookups How many lookups to time
+     * \return Lookups per second
+     */
+    double PatternDatabase::measureLookupRate(const std::size_t lookups) const
+    {
+        //make random placements ahead of time so only the lookups are timed
+        std::mt19937 randomEngine {15};
+        std::vector<cells_t> placements(4096);
+
+        for (cells_t &cells : placements)
+        {
+            std::iota(std::begin(cells), std::end(cells), 0);
+            std::shuffle(std::begin(cells), std::end(cells), randomEngine);
+        }
+
+        std::uint_fast32_t sum {0};
+        const auto start {std::chrono::steady_clock::now()};
+
+        for (std::size_t i {0}; i < lookups; ++i)
+            sum += estimate(i % patterns.size(), placements[i % placements.size()], sum % 64);
+
+        const std::chrono::duration<double> time {std::chrono::steady_clock::now() - start};
+
+        volatile std::uint_fast32_t keep {sum};//stops the loop from being optimized away
+        static_cast<void> (keep);
+
+        return static_cast<double> (lookups) / time.count();
+    }
+
+
+    /* Information */
+    ///Gets the number of patterns
+    std::size_t PatternDatabase::patternCount() const
+    {
+        return patterns.size();
+    }
+
+    /** \brief Gets the tiles in a pattern
+     *
+     * \param pattern The pattern
+     * \return The tiles, in the order they are ranked
+     */
+    const PatternDatabase::pattern_t &PatternDatabase::getPattern(const std::size_t pattern) const
+    {
+        return patterns[pattern];
+    }
+
+    /** \brief Finds which pattern a tile is in
+     *
+     * \param tile The tile
+     * \return The pattern, or PatternDatabase::NO_PATTERN
+     */
+    std::size_t PatternDatabase::patternOf(const std::uint8_t tile) const
+    {
+        return tilePatterns[tile];
+    }
+
+    ///Gets how the tables are stored
+    PatternDatabase::Encoding PatternDatabase::getEncoding() const
+    {
+        return encoding;
+    }
+
+    /** \brief Finds how much memory the tables take up
+     *
+     * \return The size of all of the tables, in bytes
+     */
+    std::size_t PatternDatabase::memoryUsage() const
+    {
+        std::size_t size {0};
+
+        for (const pattern_t &pattern : patterns)
+            size += encodedSize(pattern.size(), encoding);
+
+        return size;
+    }
+
+    /** \brief Finds how many entries a table for a pattern needs
+     *
+     * \param tiles The number of tiles in the pattern
+     * \return 16! / (16 - tiles)!
+     */
+    std::size_t PatternDatabase::tableSize(const std::size_t tiles)
+    {
+        return static_cast<std::size_t> (Rank::permutationCount(tiles));
+    }
+
+    /** \brief Finds how many bytes a table for a pattern needs
+     *
+     * \param tiles The number of tiles in the pattern
+     * \param encoding How the table is stored
+     * \return The size of the table
+     */
+    std::size_t PatternDatabase::encodedSize(const std::size_t tiles, const Encoding encoding)
+    {
+        switch (encoding)
+        {
+            case Encoding::BYTE:
+                return tableSize(tiles);
+            case Encoding::NIBBLE:
+                return (tableSize(tiles) + 1) / 2;
+            case Encoding::MOD_THREE:
+            case Encoding::MIN_FOLDED:
+            default:
+                return (tableSize(tiles) + 3) / 4;
+        }
+    }
+}
@@ -0,0 +1,141 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef PATTERNDATABASE_H
+#define PATTERNDATABASE_H
+
+
+#include "Grid15/Grid.h"
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+
+
+namespace Grid15
+{
+    /** \class PatternDatabase
+     *
+     * \brief Additive disjoint pattern databases: precomputed tables of exact move costs for groups of tiles
+     *
+     * The tiles are split into disjoint patterns. For each pattern, a breadth first search from Grid::GOAL_GRID finds the fewest moves
+     * <i>of that pattern's tiles</i> needed to put them back for every placement of them (the other tiles are treated as interchangeable and their moves are free).
+     * Because no move is counted by two patterns, the values of all of the patterns can be added together and still never overestimate.
+     *
+     * Each table is indexed by the rank of the pattern tiles' cells, so a lookup is a handful of operations no matter how big the table is.
+     * Building the default 7-8 partition takes about 1.7 GB of memory and about 20 minutes of processor time, shared between every core;
+     * 6-6-3 (about 15 seconds) and 5-5-5 (about 2 seconds) are much smaller and faster but weaker.
+     * Build once, PatternDatabase::save, and then open the file: opening memory maps it, so it is instant and shared between processes.
+     *
+     * Copies of a PatternDatabase share the same (read only) tables.
+     *
+     * The tables can also be re-encoded into less memory (see PatternDatabase::Encoding); PatternDatabase::memoryUsage and PatternDatabase::measureLookupRate help pick one.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class PatternDatabase
+    {
+        public:
+            /* Typedefs */
+            typedef std::vector<std::uint8_t> pattern_t;///<The tiles in one pattern
+            typedef std::array<std::uint8_t, 16> cells_t;///<The cell of each tile from 0 to 15 (cell == (y * 4) + x), like a single dimentional Grid::index
+
+            ///Ready made ways to split up the tiles
+            enum class Partition
+            {
+                FIVE_FIVE_FIVE, ///<Three patterns of 5 tiles; about 1.5 MB
+                SIX_SIX_THREE,  ///<Two patterns of 6 tiles and one of 3; about 11 MB
+                SEVEN_EIGHT     ///<One pattern of 7 tiles and one of 8; about 550 MB
+            };
+
+            ///How the tables are stored
+            enum class Encoding : std::uint32_t
+            {
+                BYTE,       ///<One exact value per byte
+                NIBBLE,     ///<Two values per byte, each (value - the pattern's Manhattan distance) / 2 capped at 15; exact almost everywhere, half the memory
+                MOD_THREE,  ///<Four values per byte, each the value mod 3, recovered from the value before the move; a quarter of the memory, but values are lowered so no move changes one by more than 1
+                MIN_FOLDED  ///<One byte for every 4 neighbouring ranks, holding the smallest of them; a quarter of the memory, but less accurate
+            };
+
+
+            /* Setup */
+            PatternDatabase(const Partition partition = Partition::SEVEN_EIGHT);
+            PatternDatabase(const std::vector<pattern_t> &newPatterns);
+            PatternDatabase(const std::string &file);
+            PatternDatabase(const PatternDatabase &source, const Encoding newEncoding);
+
+            static std::vector<pattern_t> getPartition(const Partition partition);
+
+
+            /* Storage */
+            void save(const std::string &file) const;
+            bool verify() const;
+
+            static constexpr std::uint32_t FILE_VERSION {2};///<The version of the pattern database file format written by PatternDatabase::save
+
+
+            /* Lookups */
+            std::uint_fast32_t estimate(const Grid &grid) const;
+            std::uint_fast32_t estimate(const cells_t &cells) const;
+            std::uint_fast32_t estimate(const std::size_t pattern, const cells_t &cells) const;
+            std::uint_fast32_t estimate(const std::size_t pattern, const cells_t &cells, const std::uint_fast32_t previous) const;
+
+            std::size_t rank(const std::size_t pattern, const cells_t &cells) const;
+            std::uint8_t lookup(const std::size_t pattern, const std::size_t rank) const;
+
+            double measureLookupRate(const std::size_t lookups = 10000000) const;
+
+
+            /* Information */
+            std::size_t patternCount() const;
+            const pattern_t &getPattern(const std::size_t pattern) const;
+            std::size_t patternOf(const std::uint8_t tile) const;
+            Encoding getEncoding() const;
+            std::size_t memoryUsage() const;
+
+            static std::size_t tableSize(const std::size_t tiles);
+            static std::size_t encodedSize(const std::size_t tiles, const Encoding encoding);
+
+            static constexpr std::size_t PATTERN_MAX    {8};    ///<The most tiles one pattern can have
+            static constexpr std::size_t NO_PATTERN     {255};  ///<What PatternDatabase::patternOf gives for tiles not in any pattern
+
+        private:
+            std::vector<pattern_t> patterns {};                 ///<The tiles in each pattern
+            std::vector<const std::uint8_t *> tables {};        ///<The moves needed for each ranked placement of each pattern; points into PatternDatabase::storage
+            std::array<std::uint8_t, 16> tilePatterns {};       ///<The pattern of each tile, or PatternDatabase::NO_PATTERN
+            Encoding encoding {Encoding::BYTE};                 ///<How PatternDatabase::tables are stored
+
+            std::shared_ptr<const void> storage {};             ///<The memory (built or memory mapped) holding the tables
+            std::shared_future<bool> checksumsValid {};         ///<If the tables match the checksums of the file they came from; checked on first use
+
+            void setPatterns(const std::vector<pattern_t> &newPatterns);
+            void build(const std::size_t pattern, std::uint8_t *table);
+            void encode(const std::size_t pattern, const std::uint8_t *source, std::uint8_t *table) const;
+            void smooth(const std::size_t pattern, std::vector<std::uint8_t> &values) const;
+            std::uint_fast32_t descend(const std::size_t pattern, cells_t cells) const;
+    };
+}
+#endif //PATTERNDATABASE_H
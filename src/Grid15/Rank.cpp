@@ -0,0 +1,365 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/Rank.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    namespace Rank
+    {
+        namespace
+        {
+            typedef std::array<std::uint8_t, CELLS> cells_t;///<A placement of up to 16 tiles
+
+            /** \brief Checks that a placement is in range and has no repeated cells
+             *
+             * \param cells The cells of the tiles
+             * \param count The number of tiles
+             * \throw std::invalid_argument If the placement is not valid
+             */
+            void checkPlacement(const std::uint8_t *cells, const std::size_t count)
+            {
+                std::uint_fast32_t used {0};
+
+                if (count > CELLS)
+                    throw std::invalid_argument {"count invalid!"};
+
+                for (std::size_t i {0}; i < count; ++i)
+                {
+                    if ((cells[i] >= CELLS) || (used & (1u << cells[i])))
+                        throw std::invalid_argument {"cells invalid!"};
+
+                    used |= 1u << cells[i];
+                }
+            }
+        }
+
+        /** \brief Ranks the cells of some tiles lexicographically among all placements of that many tiles
+         *
+         * Each cell becomes a digit counting the free cells before it (a Lehmer code), found with one bit count, so this is linear in count.
+         * Unranking keeps the free cells packed in order in one integer, so it is linear too.
+         * Does no checking; see Rank::rank for that.
+         *
+         * \param cells The cells of the tiles, in tile order
+         * \param count The number of tiles
+         * \return The rank from 0 to Rank::permutationCount(count) - 1
+         */
+        rank_t rankLexicographic(const std::uint8_t *cells, const std::size_t count)
+        {
+            rank_t rank {0};
+            std::uint_fast32_t used {0};
+
+            for (std::size_t i {0}; i < count; ++i)
+            {
+                //the digit is how many free cells come before this one
+                const std::uint_fast32_t digit {cells[i] - static_cast<std::uint_fast32_t> (__builtin_popcount(used & ((1u << cells[i]) - 1)))};
+
+                rank = {(rank * (CELLS - i)) + digit};
+                used |= 1u << cells[i];
+            }
+
+            return rank;
+        }
+
+        /** \brief The reverse of Rank::rankLexicographic
+         *
+         * \param rank The rank; must be less than Rank::permutationCount(count)
+         * \param cells Where to put the cells of the tiles, in tile order
+         * \param count The number of tiles
+         */
+        void unrankLexicographic(rank_t rank, std::uint8_t *cells, const std::size_t count)
+        {
+            std::array<std::uint_fast32_t, CELLS> digits {};
+
+            for (std::size_t i {count}; i-- > 0;)
+            {
+                digits[i] = static_cast<std::uint_fast32_t> (rank % (CELLS - i));
+                rank /= (CELLS - i);
+            }
+
+            std::uint64_t free {0xFEDCBA9876543210};//the free cells in order, one per nibble
+
+            for (std::size_t i {0}; i < count; ++i)
+            {
+                //take out the digit-th nibble and close the gap
+                const std::uint64_t below {(std::uint64_t {1} << (4 * digits[i])) - 1};
+
+                cells[i] = static_cast<std::uint8_t> ((free >> (4 * digits[i])) & 0xF);
+                free = {(free & below) | ((free >> 4) & ~below)};
+            }
+        }
+
+        /** \brief Ranks the cells of some tiles with Myrvold and Ruskey's method
+         *
+         * Starting from the cells in order, cell list position i is swapped with wherever the i-th tile's cell is; how far away that was is the digit.
+         * Does no checking; see Rank::rank for that.
+         *
+         * \param cells The cells of the tiles, in tile order
+         * \param count The number of tiles
+         * \return The rank from 0 to Rank::permutationCount(count) - 1
+         */
+        rank_t rankMyrvoldRuskey(const std::uint8_t *cells, const std::size_t count)
+        {
+            cells_t order {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}};   //the cell at each position
+            cells_t positions {order};                                              //the position of each cell
+            rank_t rank {0};
+
+            for (std::size_t i {0}; i < count; ++i)
+            {
+                const std::uint8_t position {positions[cells[i]]};
+                const std::uint8_t displaced {order[i]};
+
+                order[position] = {displaced};
+                positions[displaced] = {position};
+                //order[i] and positions[cells[i]] are never read again
+
+                rank = {(rank * (CELLS - i)) + (position - i)};
+            }
+
+            return rank;
+        }
+
+        /** \brief The reverse of Rank::rankMyrvoldRuskey
+         *
+         * \param rank The rank; must be less than Rank::permutationCount(count)
+         * \param cells Where to put the cells of the tiles, in tile order
+         * \param count The number of tiles
+         */
+        void unrankMyrvoldRuskey(rank_t rank, std::uint8_t *cells, const std::size_t count)
+        {
+            std::array<std::uint_fast32_t, CELLS> digits {};
+
+            for (std::size_t i {count}; i-- > 0;)
+            {
+                digits[i] = static_cast<std::uint_fast32_t> (rank % (CELLS - i));
+                rank /= (CELLS - i);
+            }
+
+            cells_t order {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}};
+
+            for (std::size_t i {0}; i < count; ++i)
+            {
+                const std::size_t position {i + digits[i]};
+
+                cells[i] = {order[position]};
+                order[position] = {order[i]};
+            }
+        }
+
+        /** \brief Ranks the cells of some tiles
+         *
+         * \param cells The cells of the tiles, in tile order
+         * \param count The number of tiles
+         * \param order The order to use
+         * \return The rank from 0 to Rank::permutationCount(count) - 1
+         * \throw std::invalid_argument If count is more than 16, or a cell is out of range or repeated
+         */
+        rank_t rank(const std::uint8_t *cells, const std::size_t count, const Order order)
+        {
+            checkPlacement(cells, count);
+
+            if (order == Order::MYRVOLD_RUSKEY)
+                return rankMyrvoldRuskey(cells, count);
+            else
+                return rankLexicographic(cells, count);
+        }
+
+        /** \brief The reverse of Rank::rank
+         *
+         * \param rank The rank
+         * \param cells Where to put the cells of the tiles, in tile order
+         * \param count The number of tiles
+         * \param order The order that was used
+         * \throw std::invalid_argument If count is more than 16 or the rank is too big
+         */
+        void unrank(const rank_t rank, std::uint8_t *cells, const std::size_t count, const Order order)
+        {
+            if ((count > CELLS) || (rank >= permutationCount(count)))
+                throw std::invalid_argument {"rank or count invalid!"};
+
+            if (order == Order::MYRVOLD_RUSKEY)
+                unrankMyrvoldRuskey(rank, cells, count);
+            else
+                unrankLexicographic(rank, cells, count);
+        }
+
+        /** \brief Ranks a whole Grid
+         *
+         * \param grid The Grid to use
+         * \param order The order to use
+         * \return The rank from 0 to 16! - 1
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array)
+         */
+        rank_t rank(const Grid &grid, const Order order)
+        {
+            if (GridHelp::validGrid(grid))
+            {
+                cells_t cells {};
+
+                for (std::size_t tile {0}; tile < CELLS; ++tile)
+                    cells[tile] = static_cast<std::uint8_t> ((grid.index[tile][0] * 4) + grid.index[tile][1]);
+
+                return (order == Order::MYRVOLD_RUSKEY) ? rankMyrvoldRuskey(cells.data(), CELLS) : rankLexicographic(cells.data(), CELLS);
+            }
+            else
+                throw std::invalid_argument {"Grid invalid!"};
+        }
+
+        /** \brief Ranks where some tiles of a Grid are, ignoring the others
+         *
+         * \param grid The Grid to use
+         * \param tiles The tiles to rank, in order
+         * \param order The order to use
+         * \return The rank from 0 to Rank::permutationCount(tiles.size()) - 1
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array), or a tile is out of range or repeated
+         */
+        rank_t rank(const Grid &grid, const std::vector<std::uint8_t> &tiles, const Order order)
+        {
+            if (GridHelp::validGrid(grid) && (tiles.size() <= CELLS))
+            {
+                cells_t cells {};
+
+                for (std::size_t i {0}; i < tiles.size(); ++i)
+                {
+                    if (tiles[i] > Grid::TILE_MAX)
+                        throw std::invalid_argument {"tiles invalid!"};
+
+                    cells[i] = static_cast<std::uint8_t> ((grid.index[tiles[i]][0] * 4) + grid.index[tiles[i]][1]);
+                }
+
+                return rank(cells.data(), tiles.size(), order);//repeated tiles give repeated cells, which this catches
+            }
+            else
+                throw std::invalid_argument {"Grid or tiles invalid!"};
+        }
+
+        /** \brief The reverse of ranking a whole Grid
+         *
+         * \param rank The rank
+         * \param order The order that was used
+         * \return The Grid, with a matching index
+         * \throw std::invalid_argument If the rank is 16! or more
+         */
+        Grid unrank(const rank_t rank, const Order order)
+        {
+            cells_t cells {};
+            unrank(rank, cells.data(), CELLS, order);
+
+            Grid grid {};
+
+            for (std::size_t tile {0}; tile < CELLS; ++tile)
+            {
+                grid.gridArray[cells[tile] / 4][cells[tile] % 4] = static_cast<std::uint8_t> (tile);
+                grid.index[tile][0] = static_cast<std::uint8_t> (cells[tile] / 4);
+                grid.index[tile][1] = static_cast<std::uint8_t> (cells[tile] % 4);
+            }
+
+            grid.hash = {Grid::hashGridArray(grid.gridArray)};
+            grid.metrics = {Grid::measureGridArray(grid.gridArray)};
+
+            return grid;
+        }
+
+        /** \brief Finds how many placements there are of some tiles
+         *
+         * \param count The number of tiles
+         * \return 16! / (16 - count)!
+         */
+        rank_t permutationCount(const std::size_t count)
+        {
+            rank_t size {1};
+
+            for (std::size_t i {0}; (i < count) && (i < CELLS); ++i)
+                size *= CELLS - i;
+
+            return size;
+        }
+
+        /** \brief Times ranking and unranking random placements
+         *
+         * \param order The order to time
+         * \param count The number of tiles in each placement
+         * \param ranks How many placements to rank and unrank
+         * \return Rank and unrank pairs per second
+         * \throw std::invalid_argument If count is more than 16
+         */
+        double measureRate(const Order order, const std::size_t count, const std::size_t ranks)
+        {
+            if (count > CELLS)
+                throw std::invalid_argument {"count invalid!"};
+
+            //make random placements ahead of time so only the ranking is timed
+            std::mt19937 randomEngine {15};
+            std::vector<cells_t> placements(4096);
+
+            for (cells_t &cells : placements)
+            {
+                std::iota(std::begin(cells), std::end(cells), 0);
+                std::shuffle(std::begin(cells), std::end(cells), randomEngine);
+            }
+
+            cells_t result {};
+            rank_t sum {0};
+            const auto start {std::chrono::steady_clock::now()};
+
+            if (order == Order::MYRVOLD_RUSKEY)
+            {
+                for (std::size_t i {0}; i < ranks; ++i)
+                {
+                    unrankMyrvoldRuskey(rankMyrvoldRuskey(placements[i % placements.size()].data(), count), result.data(), count);
+                    sum += result[i % CELLS];
+                }
+            }
+            else
+            {
+                for (std::size_t i {0}; i < ranks; ++i)
+                {
+                    unrankLexicographic(rankLexicographic(placements[i % placements.size()].data(), count), result.data(), count);
+                    sum += result[i % CELLS];
+                }
+            }
+
+            const std::chrono::duration<double> time {std::chrono::steady_clock::now() - start};
+
+            volatile rank_t keep {sum};//stops the loop from being optimized away
+            static_cast<void> (keep);
+
+            return static_cast<double> (ranks) / time.count();
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef RANK_H
+#define RANK_H
+
+
+#include "Grid15/Grid.h"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace Grid15
+{
+    /** \brief Turns boards and partial boards into numbers and back
+     *
+     * A placement of k tiles is the list of their cells (cell == (y * 4) + x), in a fixed tile order.
+     * Each k tile placement gets a unique rank from 0 to Rank::permutationCount(k) - 1, so ranks can index dense tables and on-disk corpora
+     * or be compared to find duplicates. A whole Grid is the placement of tiles 0 to 15, with ranks from 0 to 16! - 1.
+     *
+     * There are two orders:
+     * Order::LEXICOGRAPHIC keeps the order of the cell lists, so sorting by rank sorts the placements; this is what PatternDatabase uses.
+     * Order::MYRVOLD_RUSKEY follows Myrvold and Ruskey's swap based ranking; it does not keep any useful order, but it only swaps array entries,
+     * so it is the faster one (see Rank::measureRate).
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    namespace Rank
+    {
+        typedef std::uint64_t rank_t;///<The type used for ranks; 16! needs 45 bits
+
+        ///The ways to number placements
+        enum class Order {LEXICOGRAPHIC, MYRVOLD_RUSKEY};
+
+        constexpr std::size_t CELLS {16};///<The number of cells (and tiles, counting the no tile) on the board
+
+        rank_t rankLexicographic(const std::uint8_t *cells, const std::size_t count);
+        void unrankLexicographic(rank_t rank, std::uint8_t *cells, const std::size_t count);
+        rank_t rankMyrvoldRuskey(const std::uint8_t *cells, const std::size_t count);
+        void unrankMyrvoldRuskey(rank_t rank, std::uint8_t *cells, const std::size_t count);
+
+        rank_t rank(const std::uint8_t *cells, const std::size_t count, const Order order = Order::LEXICOGRAPHIC);
+        void unrank(const rank_t rank, std::uint8_t *cells, const std::size_t count, const Order order = Order::LEXICOGRAPHIC);
+
+        rank_t rank(const Grid &grid, const Order order = Order::LEXICOGRAPHIC);
+        rank_t rank(const Grid &grid, const std::vector<std::uint8_t> &tiles, const Order order = Order::LEXICOGRAPHIC);
+        Grid unrank(const rank_t rank, const Order order = Order::LEXICOGRAPHIC);
+
+        rank_t permutationCount(const std::size_t count);
+        double measureRate(const Order order, const std::size_t count = CELLS, const std::size_t ranks = 10000000);
+    }
+}
+#endif //RANK_H
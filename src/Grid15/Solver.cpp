@@ -0,0 +1,946 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/Solver.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    namespace Solver
+    {
+        namespace
+        {
+            constexpr std::uint_fast32_t CELLS  {16};   ///<The number of cells on the board
+            constexpr std::uint_fast32_t WIDTH  {4};    ///<The number of cells in a row or colum
+            constexpr std::uint8_t NO_CELL      {16};   ///<Not a cell; used when there is no previous blank position
+
+            /** \brief Finds the cell a tile belongs on in Grid::GOAL_GRID, counting from the top left
+             *
+             * \param tile The tile
+             * \return The goal cell of the tile
+             */
+            constexpr std::uint_fast32_t goalCell(const std::uint_fast32_t tile)
+            {
+                return (tile == Grid::NO_TILE) ? (CELLS - 1) : (tile - 1);
+            }
+
+            /** \brief Precomputed lookup tables used by the search
+             *
+             * Rows and colums are encoded as base 5 "line codes": each cell of a line is a digit, 0 if the tile on it does not belong in that line,
+             * or the tile's goal position in the line plus 1 if it does. Tables::rowWeight and Tables::columWeight hold the amount a tile on a cell adds to its line's code.
+             */
+            struct Tables
+            {
+                std::array<std::array<std::uint8_t, CELLS>, CELLS>  distance {};         ///<Manhattan distance of [tile] on [cell] from its goal cell
+                std::array<std::array<std::uint8_t, 4>, CELLS>      neighbours {};       ///<The cells next to [cell]
+                std::array<std::uint8_t, CELLS>                     neighbourCount {};   ///<How many cells are next to [cell]
+                std::array<std::array<std::uint16_t, CELLS>, CELLS> rowWeight {};        ///<What [tile] on [cell] adds to its row's line code
+                std::array<std::array<std::uint16_t, CELLS>, CELLS> columWeight {};      ///<What [tile] on [cell] adds to its colum's line code
+                std::array<std::uint8_t, 625>                       lineConflict {};     ///<Linear conflict moves of a line code
+            };
+
+            /** \brief Generates Tables at compile time
+             *
+             * \return The filled in Tables
+             */
+            constexpr Tables makeTables()
+            {
+                Tables tables {};
+
+                constexpr std::uint_fast32_t POWERS[4] {1, 5, 25, 125};
+
+                for (std::uint_fast32_t tile {0}; tile < CELLS; ++tile)
+                    for (std::uint_fast32_t cell {0}; cell < CELLS; ++cell)
+                    {
+                        const std::uint_fast32_t goalY {goalCell(tile) / WIDTH}, goalX {goalCell(tile) % WIDTH};
+                        const std::uint_fast32_t y {cell / WIDTH}, x {cell % WIDTH};
+
+                        if (tile != Grid::NO_TILE)//the no tile never counts
+                        {
+                            tables.distance[tile][cell] = static_cast<std::uint8_t> ((y > goalY ? y - goalY : goalY - y) + (x > goalX ? x - goalX : goalX - x));
+
+                            if (y == goalY)
+                                tables.rowWeight[tile][cell] = static_cast<std::uint16_t> ((goalX + 1) * POWERS[x]);
+                            if (x == goalX)
+                                tables.columWeight[tile][cell] = static_cast<std::uint16_t> ((goalY + 1) * POWERS[y]);
+                        }
+                    }
+
+                for (std::uint_fast32_t cell {0}; cell < CELLS; ++cell)
+                {
+                    const std::uint_fast32_t y {cell / WIDTH}, x {cell % WIDTH};
+                    std::uint_fast32_t count {0};
+
+                    if (y > 0)
+                        tables.neighbours[cell][count++] = static_cast<std::uint8_t> (cell - WIDTH);
+                    if (y < WIDTH - 1)
+                        tables.neighbours[cell][count++] = static_cast<std::uint8_t> (cell + WIDTH);
+                    if (x > 0)
+                        tables.neighbours[cell][count++] = static_cast<std::uint8_t> (cell - 1);
+                    if (x < WIDTH - 1)
+                        tables.neighbours[cell][count++] = static_cast<std::uint8_t> (cell + 1);
+
+                    tables.neighbourCount[cell] = static_cast<std::uint8_t> (count);
+                }
+
+                //every line has to give up its longest increasing run of goal positions; each other tile in the line costs 2 extra moves to get out of the way
+                for (std::uint_fast32_t code {0}; code < 625; ++code)
+                {
+                    std::uint_fast32_t goals[4] {};
+                    std::uint_fast32_t length {0};
+
+                    for (std::uint_fast32_t i {0}; i < 4; ++i)
+                        if (((code / POWERS[i]) % 5) != 0)
+                            goals[length++] = {(code / POWERS[i]) % 5};
+
+                    std::uint_fast32_t longestRun[4] {};
+                    std::uint_fast32_t longest {0};
+
+                    for (std::uint_fast32_t i {0}; i < length; ++i)
+                    {
+                        longestRun[i] = {1};
+
+                        for (std::uint_fast32_t j {0}; j < i; ++j)
+                            if (goals[j] < goals[i] && longestRun[j] + 1 > longestRun[i])
+                                longestRun[i] = {longestRun[j] + 1};
+
+                        if (longestRun[i] > longest)
+                            longest = {longestRun[i]};
+                    }
+
+                    tables.lineConflict[code] = static_cast<std::uint8_t> (2 * (length - longest));
+                }
+
+                return tables;
+            }
+
+            constexpr Tables TABLES {makeTables()};///<The lookup tables, generated at compile time
+
+            /** \brief A single dimentional board used by the search; much cheaper to change than a Grid
+             *
+             * Cells are numbered from the top left to the bottom right (cell == (y * 4) + x)
+             */
+            struct Board
+            {
+                std::array<std::uint8_t, CELLS> tiles {};   ///<The tile on each cell
+                std::array<std::uint8_t, CELLS> cells {};   ///<The cell of each tile
+                std::uint8_t blank {};                      ///<The cell of the no tile
+
+                /** \brief Creates a Board from a grid array
+                 *
+                 * \param gridArray The grid array to copy; must be valid
+                 */
+                explicit Board(const Grid::gridArray_t &gridArray)
+                {
+                    for (std::uint_fast32_t i {0}; i < 4; ++i)
+                        for (std::uint_fast32_t j {0}; j < 4; ++j)
+                        {
+                            tiles[(i * WIDTH) + j] = {gridArray[i][j]};
+                            cells[gridArray[i][j]] = static_cast<std::uint8_t> ((i * WIDTH) + j);
+                        }
+
+                    blank = {cells[Grid::NO_TILE]};
+                }
+
+                /** \brief Slides the tile on a cell into the no tile. Does not check anything
+                 *
+                 * \param cell The cell of the tile; must be next to the no tile
+                 */
+                void slide(const std::uint_fast32_t cell)
+                {
+                    const std::uint8_t tile {tiles[cell]};
+
+                    tiles[blank] = {tile};
+                    cells[tile] = {blank};
+
+                    tiles[cell] = {Grid::NO_TILE};
+                    cells[Grid::NO_TILE] = static_cast<std::uint8_t> (cell);
+                    blank = static_cast<std::uint8_t> (cell);
+                }
+
+                /** \brief Checks if the Board is equal to Grid::GOAL_GRID
+                 *
+                 * \return If the Board is solved
+                 */
+                bool solved() const
+                {
+                    for (std::uint_fast32_t tile {0}; tile < CELLS; ++tile)
+                        if (cells[tile] != goalCell(tile))
+                            return false;
+
+                    return true;
+                }
+            };
+
+            /** \brief The Manhattan distance plus linear conflict heuristic, updated per move
+             *
+             * The Manhattan distance changes by exactly one per move, and a move only changes the order of tiles in the two lines it crosses,
+             * so only those two line codes have to be looked up again.
+             */
+            class ManhattanConflict
+            {
+                public:
+                    /** \brief Recalculates everything for a board
+                     *
+                     * \param board The board
+                     * \return The estimate for the board
+                     */
+                    std::uint_fast32_t reset(const Board &board)
+                    {
+                        rows.fill(0);
+                        colums.fill(0);
+
+                        std::uint_fast32_t estimate {0};
+
+                        for (std::uint_fast32_t cell {0}; cell < CELLS; ++cell)
+                        {
+                            const std::uint8_t tile {board.tiles[cell]};
+
+                            rows[cell / WIDTH] += TABLES.rowWeight[tile][cell];
+                            colums[cell % WIDTH] += TABLES.columWeight[tile][cell];
+                            estimate += TABLES.distance[tile][cell];
+                        }
+
+                        for (std::uint_fast32_t i {0}; i < WIDTH; ++i)
+                            estimate += TABLES.lineConflict[rows[i]] + TABLES.lineConflict[colums[i]];
+
+                        return estimate;
+                    }
+
+                    /** \brief Finds how much the estimate changes if a tile is slid
+                     *
+                     * \param board The board before the slide (unused)
+                     * \param tile The tile
+                     * \param from The cell the tile is on
+                     * \param to The cell the tile would slide to (the no tile's cell)
+                     * \return The change in the estimate
+                     */
+                    std::int_fast32_t delta(const Board &/*board*/, const std::uint_fast32_t tile, const std::uint_fast32_t from, const std::uint_fast32_t to) const
+                    {
+                        std::int_fast32_t change {TABLES.distance[tile][to] - TABLES.distance[tile][from]};
+
+                        if ((from / WIDTH) == (to / WIDTH))//sliding sideways only reorders the two colums
+                        {
+                            const std::uint_fast32_t oldColum {colums[from % WIDTH]}, newColum {colums[to % WIDTH]};
+
+                            change += TABLES.lineConflict[oldColum - TABLES.columWeight[tile][from]] + TABLES.lineConflict[newColum + TABLES.columWeight[tile][to]];
+                            change -= TABLES.lineConflict[oldColum] + TABLES.lineConflict[newColum];
+                        }
+                        else//sliding up or down only reorders the two rows
+                        {
+                            const std::uint_fast32_t oldRow {rows[from / WIDTH]}, newRow {rows[to / WIDTH]};
+
+                            change += TABLES.lineConflict[oldRow - TABLES.rowWeight[tile][from]] + TABLES.lineConflict[newRow + TABLES.rowWeight[tile][to]];
+                            change -= TABLES.lineConflict[oldRow] + TABLES.lineConflict[newRow];
+                        }
+
+                        return change;
+                    }
+
+                    /** \brief Updates the line codes after a tile slides; call again with from and to swapped to undo
+                     *
+                     * \param board The board after the slide (unused)
+                     * \param tile The tile
+                     * \param from The cell the tile was on
+                     * \param to The cell the tile slid to
+                     */
+                    void slide(const Board &/*board*/, const std::uint_fast32_t tile, const std::uint_fast32_t from, const std::uint_fast32_t to)
+                    {
+                        rows[from / WIDTH] -= TABLES.rowWeight[tile][from];
+                        rows[to / WIDTH] += TABLES.rowWeight[tile][to];
+                        colums[from % WIDTH] -= TABLES.columWeight[tile][from];
+                        colums[to % WIDTH] += TABLES.columWeight[tile][to];
+                    }
+
+                private:
+                    std::array<std::uint16_t, WIDTH> rows {};   ///<The line code of each row
+                    std::array<std::uint16_t, WIDTH> colums {}; ///<The line code of each colum
+            };
+
+            /** \brief The sum of the additive pattern databases, updated per move
+             *
+             * Only the pattern of the tile being slid changes, so only its table is looked up again.
+             * The value before the move is always passed along, so PatternDatabase::Encoding::MOD_THREE tables work too.
+             */
+            class PatternHeuristic
+            {
+                public:
+                    /** \brief Creates the heuristic
+                     *
+                     * \param newDatabase The pattern databases to use; must outlive the heuristic
+                     */
+                    explicit PatternHeuristic(const PatternDatabase &newDatabase) : database {&newDatabase}, values(newDatabase.patternCount(), 0) {}
+
+                    /** \brief Looks up every pattern for a board
+                     *
+                     * \param board The board
+                     * \return The estimate for the board
+                     */
+                    std::uint_fast32_t reset(const Board &board)
+                    {
+                        std::uint_fast32_t estimate {0};
+
+                        for (std::size_t i {0}; i < values.size(); ++i)
+                        {
+                            values[i] = {database->estimate(i, board.cells)};
+                            estimate += values[i];
+                        }
+
+                        return estimate;
+                    }
+
+                    /** \brief Finds how much the estimate changes if a tile is slid
+                     *
+                     * \param board The board before the slide
+                     * \param tile The tile
+                     * \param from The cell the tile is on (unused)
+                     * \param to The cell the tile would slide to (the no tile's cell)
+                     * \return The change in the estimate
+                     */
+                    std::int_fast32_t delta(const Board &board, const std::uint_fast32_t tile, const std::uint_fast32_t /*from*/, const std::uint_fast32_t to) const
+                    {
+                        const std::size_t pattern {database->patternOf(static_cast<std::uint8_t> (tile))};
+
+                        if (pattern == PatternDatabase::NO_PATTERN)
+                            return 0;
+
+                        PatternDatabase::cells_t cells {board.cells};
+                        cells[tile] = static_cast<std::uint8_t> (to);
+
+                        return static_cast<std::int_fast32_t> (database->estimate(pattern, cells, values[pattern])) - static_cast<std::int_fast32_t> (values[pattern]);
+                    }
+
+                    /** \brief Looks up the slid tile's pattern again after a tile slides (or slides back)
+                     *
+                     * \param board The board after the slide
+                     * \param tile The tile
+                     * \param from The cell the tile was on (unused)
+                     * \param to The cell the tile slid to (unused)
+                     */
+                    void slide(const Board &board, const std::uint_fast32_t tile, const std::uint_fast32_t /*from*/, const std::uint_fast32_t /*to*/)
+                    {
+                        const std::size_t pattern {database->patternOf(static_cast<std::uint8_t> (tile))};
+
+                        if (pattern != PatternDatabase::NO_PATTERN)
+                            values[pattern] = {database->estimate(pattern, board.cells, values[pattern])};
+                    }
+
+                private:
+                    const PatternDatabase *database {};         ///<The pattern databases
+                    std::vector<std::uint_fast32_t> values {};  ///<The current value of each pattern
+            };
+
+            /** \brief The walking distance of the rows plus the walking distance of the colums, updated per move
+             *
+             * A tile sliding up or down only changes the row summary, and a tile sliding left or right only changes the colum summary.
+             */
+            class WalkingHeuristic
+            {
+                public:
+                    /** \brief Creates the heuristic
+                     *
+                     * \param newTables The walking distance tables to use; must outlive the heuristic
+                     */
+                    explicit WalkingHeuristic(const WalkingDistance &newTables) : tables {&newTables} {}
+
+                    /** \brief Finds the row and colum summaries of a board
+                     *
+                     * \param board The board
+                     * \return The estimate for the board
+                     */
+                    std::uint_fast32_t reset(const Board &board)
+                    {
+                        rows = {tables->rowState(board.cells)};
+                        colums = {tables->columState(board.cells)};
+
+                        return tables->distance(rows) + tables->distance(colums);
+                    }
+
+                    /** \brief Finds how much the estimate changes if a tile is slid
+                     *
+                     * \param board The board before the slide (unused)
+                     * \param tile The tile
+                     * \param from The cell the tile is on
+                     * \param to The cell the tile would slide to (the no tile's cell)
+                     * \return The change in the estimate
+                     */
+                    std::int_fast32_t delta(const Board &/*board*/, const std::uint_fast32_t tile, const std::uint_fast32_t from, const std::uint_fast32_t to) const
+                    {
+                        const WalkingDistance::state_t current {((from / WIDTH) != (to / WIDTH)) ? rows : colums};
+                        return static_cast<std::int_fast32_t> (tables->distance(next(tile, from, to))) - static_cast<std::int_fast32_t> (tables->distance(current));
+                    }
+
+                    /** \brief Updates the changed summary after a tile slides (or slides back)
+                     *
+                     * \param board The board after the slide (unused)
+                     * \param tile The tile
+                     * \param from The cell the tile was on
+                     * \param to The cell the tile slid to
+                     */
+                    void slide(const Board &/*board*/, const std::uint_fast32_t tile, const std::uint_fast32_t from, const std::uint_fast32_t to)
+                    {
+                        if ((from / WIDTH) != (to / WIDTH))
+                            rows = {next(tile, from, to)};
+                        else
+                            colums = {next(tile, from, to)};
+                    }
+
+                private:
+                    const WalkingDistance *tables {};   ///<The walking distance tables
+                    WalkingDistance::state_t rows {};   ///<The current row summary
+                    WalkingDistance::state_t colums {}; ///<The current colum summary
+
+                    /** \brief Finds the summary a slide changes to
+                     *
+                     * \param tile The tile
+                     * \param from The cell the tile is on
+                     * \param to The cell the tile slides to; the no tile moves the other way
+                     * \return The new row summary for an up/down slide, or the new colum summary for a left/right slide
+                     */
+                    WalkingDistance::state_t next(const std::uint_fast32_t tile, const std::uint_fast32_t from, const std::uint_fast32_t to) const
+                    {
+                        const std::uint_fast32_t goal {goalCell(tile)};
+
+                        if ((from / WIDTH) != (to / WIDTH))
+                            return tables->slide(rows, (from / WIDTH) > (to / WIDTH), static_cast<std::uint8_t> (goal / WIDTH));
+                        else
+                            return tables->slide(colums, (from % WIDTH) > (to % WIDTH), static_cast<std::uint8_t> (goal % WIDTH));
+                    }
+            };
+
+            /** \brief An IDA* search over a Board
+             *
+             * \tparam Heuristic The admissible estimate to use; needs reset(), delta() and slide() like ManhattanConflict, PatternHeuristic and WalkingHeuristic
+             */
+            template <class Heuristic>
+            class Search
+            {
+                public:
+                    /** \brief Sets up a search
+                     *
+                     * \param grid The Grid to solve; must be valid and solvable
+                     * \param newHeuristic The heuristic to use
+                     */
+                    Search(const Grid &grid, const Heuristic &newHeuristic) : board {grid.gridArray}, heuristic {newHeuristic} {}
+
+                    /** \brief Sets up a search of part of the tree, for ParallelSearch
+                     *
+                     * \param newBoard The board to start from
+                     * \param newHeuristic The heuristic, already up to date for newBoard
+                     * \param newPath The tiles slid to get to newBoard
+                     * \param newStop Set by another thread to stop the search early; may be nullptr
+                     */
+                    Search(const Board &newBoard, const Heuristic &newHeuristic, const moves_t &newPath, const std::atomic<bool> *newStop) :
+                        board {newBoard}, heuristic {newHeuristic}, path {newPath}, stop {newStop} {}
+
+                    /** \brief Runs the search until an optimal solution is found
+                     *
+                     * \return The solution
+                     */
+                    Result run()
+                    {
+                        std::uint_fast32_t estimate {heuristic.reset(board)};
+                        bound = {estimate};
+
+                        if (!board.solved())
+                        {
+                            //deepen the bound to the smallest estimate that was too big last time until a solution is found
+                            while (true)
+                            {
+                                nextBound = {std::numeric_limits<std::uint_fast32_t>::max()};
+
+                                if (search(0, estimate, NO_CELL))
+                                    break;
+
+                                bound = {nextBound};
+                            }
+                        }
+
+                        return Result {path, nodesExpanded};
+                    }
+
+                    /** \brief Runs one iteration from the board the search was set up with
+                     *
+                     * \param depth The number of moves already made (the length of the starting path)
+                     * \param estimate The heuristic estimate for the starting board
+                     * \param previous Where the no tile was before the last move, or NO_CELL
+                     * \param newBound The most moves (made plus estimated) a path can have
+                     * \return If a solution was found (see Search::getPath); if not, Search::getNextBound is the smallest cost over the bound
+                     */
+                    bool runBound(const std::uint_fast32_t depth, const std::uint_fast32_t estimate, const std::uint_fast32_t previous, const std::uint_fast32_t newBound)
+                    {
+                        bound = {newBound};
+                        nextBound = {std::numeric_limits<std::uint_fast32_t>::max()};
+
+                        return search(depth, estimate, previous);
+                    }
+
+                    ///Gets the tiles slid to get to the current board; the solution after Search::runBound returns true
+                    const moves_t &getPath() const {return path;}
+                    ///Gets how many boards have been looked at
+                    std::uint64_t getNodesExpanded() const {return nodesExpanded;}
+                    ///Gets the smallest cost that went over the bound in the last iteration
+                    std::uint_fast32_t getNextBound() const {return nextBound;}
+
+                private:
+                    /** \brief Searches every path from the current board that fits within the bound
+                     *
+                     * \param depth The number of moves made so far
+                     * \param estimate The heuristic estimate for the current board
+                     * \param previous Where the no tile was before the last move, so the move is not undone right away
+                     * \return If a solution was found (it is in Search::path)
+                     */
+                    bool search(const std::uint_fast32_t depth, const std::uint_fast32_t estimate, const std::uint_fast32_t previous)
+                    {
+                        ++nodesExpanded;
+
+                        if ((stop != nullptr) && stop->load(std::memory_order_relaxed))
+                            return false;
+
+                        const std::uint_fast32_t blank {board.blank};
+
+                        for (std::uint_fast32_t i {0}; i < TABLES.neighbourCount[blank]; ++i)
+                        {
+                            const std::uint_fast32_t cell {TABLES.neighbours[blank][i]};
+
+                            if (cell == previous)
+                                continue;
+
+                            const std::uint_fast32_t tile {board.tiles[cell]};
+                            const std::uint_fast32_t newEstimate {estimate + heuristic.delta(board, tile, cell, blank)};
+                            const std::uint_fast32_t cost {depth + 1 + newEstimate};
+
+                            if (cost > bound)
+                            {
+                                if (cost < nextBound)
+                                    nextBound = {cost};
+                                continue;
+                            }
+
+                            //slide the tile
+                            board.slide(cell);
+                            heuristic.slide(board, tile, cell, blank);
+                            path.push_back(static_cast<std::uint8_t> (tile));
+
+                            if ((newEstimate == 0 && board.solved()) || search(depth + 1, newEstimate, blank))
+                                return true;
+
+                            //slide it back
+                            path.pop_back();
+                            board.slide(blank);
+                            heuristic.slide(board, tile, blank, cell);
+                        }
+
+                        return false;
+                    }
+
+                    Board board;                            ///<The board being searched; changed and changed back in place
+                    Heuristic heuristic;                    ///<The estimate for Search::board
+                    moves_t path {};                        ///<The tiles slid to get to Search::board
+                    std::uint64_t nodesExpanded {0};        ///<How many boards have been looked at
+                    std::uint_fast32_t bound {0};           ///<The most moves (made plus estimated) a path can have this iteration
+                    std::uint_fast32_t nextBound {0};       ///<The smallest cost that went over Search::bound this iteration
+                    const std::atomic<bool> *stop {nullptr};///<When set, the search gives up; used to stop other threads once a solution is found
+            };
+
+            /** \brief An IDA* search split across threads
+             *
+             * Each iteration, the top of the tree is expanded breadth first (within the bound) until there are plenty of subtrees for every thread.
+             * Each thread starts with an equal share of the subtrees in its own queue, searches from the back of it, and steals from the front of
+             * other threads' queues when it runs out, so threads that got small subtrees help with the big ones.
+             * All threads share the bound of the iteration and the next bound is the smallest over all of them, so every iteration looks at exactly
+             * the same paths as the single threaded search. Any solution found within the bound is optimal, so the first one stops every thread.
+             *
+             * \tparam Heuristic The admissible estimate to use, like for Search; it is copied for each subtree
+             */
+            template <class Heuristic>
+            class ParallelSearch
+            {
+                public:
+                    /** \brief Sets up a search
+                     *
+                     * \param grid The Grid to solve; must be valid and solvable
+                     * \param newHeuristic The heuristic to use
+                     * \param newThreads The number of threads to use; at least 1
+                     */
+                    ParallelSearch(const Grid &grid, const Heuristic &newHeuristic, const std::size_t newThreads) :
+                        root {Board {grid.gridArray}, newHeuristic, {}, 0, 0, NO_CELL}, threads {newThreads}, queues(newThreads) {}
+
+                    /** \brief Runs the search until an optimal solution is found
+                     *
+                     * \return The solution
+                     */
+                    Result run()
+                    {
+                        root.estimate = {root.heuristic.reset(root.board)};
+                        std::uint_fast32_t bound {root.estimate};
+
+                        if (root.board.solved())
+                            return Result {};
+
+                        while (true)
+                        {
+                            nextBound = {std::numeric_limits<std::uint_fast32_t>::max()};
+
+                            if (iterate(bound))
+                                break;
+
+                            bound = {nextBound};
+                        }
+
+                        return Result {solution, nodesExpanded};
+                    }
+
+                private:
+                    ///A subtree waiting to be searched
+                    struct Task
+                    {
+                        Board board;                    ///<The board at the top of the subtree
+                        Heuristic heuristic;            ///<The heuristic, up to date for Task::board
+                        moves_t path;                   ///<The tiles slid to get to Task::board
+                        std::uint_fast32_t depth;       ///<The number of moves in Task::path
+                        std::uint_fast32_t estimate;    ///<The heuristic estimate for Task::board
+                        std::uint_fast32_t previous;    ///<Where the no tile was before the last move
+                    };
+
+                    ///A thread's own subtrees; taken from the back by the owner and from the front by thieves
+                    struct WorkQueue
+                    {
+                        std::mutex mutex {};            ///<Guards WorkQueue::tasks
+                        std::deque<std::size_t> tasks {};///<Indexes into ParallelSearch::tasks
+                    };
+
+                    static constexpr std::size_t TASKS_PER_THREAD {64};///<How many subtrees to aim for per thread; more balances better but costs more to expand
+
+                    /** \brief Runs one iteration
+                     *
+                     * \param bound The most moves (made plus estimated) a path can have
+                     * \return If a solution was found
+                     */
+                    bool iterate(const std::uint_fast32_t bound)
+                    {
+                        if (split(bound))
+                            return true;
+
+                        if (tasks.empty())
+                            return false;
+
+                        //deal the subtrees out like cards so every queue gets some of each depth of the tree
+                        for (std::size_t i {0}; i < tasks.size(); ++i)
+                            queues[i % threads].tasks.push_back(i);
+
+                        std::vector<std::thread> workers {};
+
+                        for (std::size_t i {1}; i < threads; ++i)
+                            workers.emplace_back(&ParallelSearch::work, this, i, bound);
+
+                        work(0, bound);
+
+                        for (std::thread &worker : workers)
+                            worker.join();
+
+                        return found.load();
+                    }
+
+                    /** \brief Expands the top of the tree into ParallelSearch::tasks
+                     *
+                     * \param bound The most moves (made plus estimated) a path can have
+                     * \return If a solution was found while expanding (it is in ParallelSearch::solution)
+                     */
+                    bool split(const std::uint_fast32_t bound)
+                    {
+                        tasks.assign(1, root);
+
+                        while (!tasks.empty() && (tasks.size() < threads * TASKS_PER_THREAD))
+                        {
+                            std::vector<Task> children {};
+
+                            for (const Task &task : tasks)
+                            {
+                                ++nodesExpanded;
+
+                                const std::uint_fast32_t blank {task.board.blank};
+
+                                for (std::uint_fast32_t i {0}; i < TABLES.neighbourCount[blank]; ++i)
+                                {
+                                    const std::uint_fast32_t cell {TABLES.neighbours[blank][i]};
+
+                                    if (cell == task.previous)
+                                        continue;
+
+                                    const std::uint_fast32_t tile {task.board.tiles[cell]};
+                                    const std::uint_fast32_t newEstimate {task.estimate + task.heuristic.delta(task.board, tile, cell, blank)};
+                                    const std::uint_fast32_t cost {task.depth + 1 + newEstimate};
+
+                                    if (cost > bound)
+                                    {
+                                        if (cost < nextBound)
+                                            nextBound = {cost};
+                                        continue;
+                                    }
+
+                                    children.push_back(task);
+
+                                    Task &child {children.back()};
+                                    child.board.slide(cell);
+                                    child.heuristic.slide(child.board, tile, cell, blank);
+                                    child.path.push_back(static_cast<std::uint8_t> (tile));
+                                    child.depth = {task.depth + 1};
+                                    child.estimate = {newEstimate};
+                                    child.previous = {blank};
+
+                                    if (newEstimate == 0 && child.board.solved())
+                                    {
+                                        solution = {child.path};
+                                        return true;
+                                    }
+                                }
+                            }
+
+                            tasks.swap(children);
+                        }
+
+                        return false;
+                    }
+
+                    /** \brief Searches subtrees until there are none left or a solution is found; run by each thread
+                     *
+                     * \param worker The thread's number, and so its queue
+                     * \param bound The most moves (made plus estimated) a path can have
+                     */
+                    void work(const std::size_t worker, const std::uint_fast32_t bound)
+                    {
+                        std::uint64_t nodes {0};
+                        std::uint_fast32_t smallest {std::numeric_limits<std::uint_fast32_t>::max()};
+                        std::size_t task {0};
+
+                        while (!found.load(std::memory_order_relaxed) && takeTask(worker, task))
+                        {
+                            Search<Heuristic> search {tasks[task].board, tasks[task].heuristic, tasks[task].path, &found};
+                            const bool solved {search.runBound(tasks[task].depth, tasks[task].estimate, tasks[task].previous, bound)};
+
+                            nodes += search.getNodesExpanded();
+
+                            if (search.getNextBound() < smallest)
+                                smallest = {search.getNextBound()};
+
+                            if (solved)
+                            {
+                                std::lock_guard<std::mutex> lock {resultMutex};
+
+                                if (!found.exchange(true))
+                                    solution = {search.getPath()};
+                            }
+                        }
+
+                        std::lock_guard<std::mutex> lock {resultMutex};
+
+                        nodesExpanded += nodes;
+                        if (smallest < nextBound)
+                            nextBound = {smallest};
+                    }
+
+                    /** \brief Takes the next subtree from a thread's own queue, or steals one from another thread
+                     *
+                     * \param worker The thread's number
+                     * \param task Set to the subtree taken
+                     * \return If a subtree was taken (false once every queue is empty)
+                     */
+                    bool takeTask(const std::size_t worker, std::size_t &task)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock {queues[worker].mutex};
+
+                            if (!queues[worker].tasks.empty())
+                            {
+                                task = {queues[worker].tasks.back()};
+                                queues[worker].tasks.pop_back();
+                                return true;
+                            }
+                        }
+
+                        //queues only empty during an iteration, so one pass over the others is enough
+                        for (std::size_t i {1}; i < threads; ++i)
+                        {
+                            WorkQueue &victim {queues[(worker + i) % threads]};
+                            std::lock_guard<std::mutex> lock {victim.mutex};
+
+                            if (!victim.tasks.empty())
+                            {
+                                task = {victim.tasks.front()};
+                                victim.tasks.pop_front();
+                                return true;
+                            }
+                        }
+
+                        return false;
+                    }
+
+                    Task root;                                  ///<The board to solve, as a subtree of its own
+                    std::size_t threads;                        ///<The number of threads to use
+                    std::vector<WorkQueue> queues;              ///<Each thread's subtrees
+                    std::vector<Task> tasks {};                 ///<The subtrees of the current iteration
+                    std::atomic<bool> found {false};            ///<Set once a solution is found, which stops every thread
+                    std::mutex resultMutex {};                  ///<Guards ParallelSearch::solution, ParallelSearch::nodesExpanded and ParallelSearch::nextBound while threads run
+                    moves_t solution {};                        ///<The solution
+                    std::uint64_t nodesExpanded {0};            ///<How many boards have been looked at, by every thread
+                    std::uint_fast32_t nextBound {0};           ///<The smallest cost that went over the bound this iteration
+            };
+
+            /** \brief Runs a single threaded or parallel search
+             *
+             * \param grid The Grid to solve; must be valid and solvable
+             * \param heuristic The heuristic to use
+             * \param threads The number of threads to use; 0 for one per hardware thread
+             * \return The solution
+             */
+            template <class Heuristic>
+            Result runSearch(const Grid &grid, const Heuristic &heuristic, std::size_t threads)
+            {
+                if (threads == 0)
+                    threads = {std::max<std::size_t> (std::thread::hardware_concurrency(), 1)};
+
+                if (threads == 1)
+                {
+                    Search<Heuristic> search {grid, heuristic};
+                    return search.run();
+                }
+                else
+                {
+                    ParallelSearch<Heuristic> search {grid, heuristic, threads};
+                    return search.run();
+                }
+            }
+
+            /** \brief Checks that a Grid can be given to Search
+             *
+             * \param grid The Grid to check
+             * \throw std::invalid_argument If the Grid is not valid or cannot be solved
+             */
+            void checkSolvable(const Grid &grid)
+            {
+                if (!GridHelp::solvableGrid(grid))//throws if the Grid is invalid too
+                    throw std::invalid_argument {"Grid unsolvable!"};
+            }
+        }
+
+        /** \brief Finds a shortest list of moves that solves a Grid
+         *
+         * \param grid The Grid to solve
+         * \param threads The number of threads to search with; 0 for one per hardware thread
+         * \return The moves and some search statistics
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array) or cannot be solved
+         */
+        Result solve(const Grid &grid, const std::size_t threads)
+        {
+            checkSolvable(grid);
+
+            return runSearch(grid, ManhattanConflict {}, threads);
+        }
+
+        /** \brief Finds a shortest list of moves that solves a Grid, using pattern databases instead of Manhattan distance and linear conflict
+         *
+         * \param grid The Grid to solve
+         * \param database The pattern databases to use
+         * \param threads The number of threads to search with; 0 for one per hardware thread
+         * \return The moves and some search statistics
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array) or cannot be solved, or the database is corrupted (see PatternDatabase::verify)
+         */
+        Result solve(const Grid &grid, const PatternDatabase &database, const std::size_t threads)
+        {
+            checkSolvable(grid);
+
+            const Result result {runSearch(grid, PatternHeuristic {database}, threads)};
+
+            //the tables are checked in the background while the search runs; a bad table could overestimate and give a longer solution
+            if (!database.verify())
+                throw std::invalid_argument {"Pattern database corrupted!"};
+
+            return result;
+        }
+
+        /** \brief Finds a shortest list of moves that solves a Grid, using walking distance instead of Manhattan distance and linear conflict
+         *
+         * \param grid The Grid to solve
+         * \param tables The walking distance tables to use
+         * \param threads The number of threads to search with; 0 for one per hardware thread
+         * \return The moves and some search statistics
+         * \throw std::invalid_argument If the Grid is not valid (index and/or grid array) or cannot be solved
+         */
+        Result solve(const Grid &grid, const WalkingDistance &tables, const std::size_t threads)
+        {
+            checkSolvable(grid);
+
+            return runSearch(grid, WalkingHeuristic {tables}, threads);
+        }
+
+        /** \brief Sums the distance of each tile from where it is in Grid::GOAL_GRID
+         *
+         * Just reads Grid::Metrics::manhattanDistance
+         *
+         * \param grid The Grid to use; must be valid
+         * \return The Manhattan distance
+         */
+        std::uint_fast32_t manhattanDistance(const Grid &grid)
+        {
+            return grid.metrics.manhattanDistance;
+        }
+
+        /** \brief Counts the extra moves needed because tiles in their goal row or colum are in the wrong order
+         *
+         * \param grid The Grid to use
+         * \return The linear conflict moves (always even)
+         * \throw std::invalid_argument If the grid array is not valid
+         */
+        std::uint_fast32_t linearConflict(const Grid &grid)
+        {
+            if (GridHelp::validGridArray(grid.gridArray))
+            {
+                const Board board {grid.gridArray};
+
+                ManhattanConflict heuristic {};
+                return heuristic.reset(board) - grid.metrics.manhattanDistance;
+            }
+            else
+                throw std::invalid_argument {"Grid invalid!"};
+        }
+    }
+}
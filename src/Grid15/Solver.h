@@ -0,0 +1,69 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef SOLVER_H
+#define SOLVER_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace Grid15
+{
+    /** \brief Finds optimal (shortest) solutions for a Grid
+     *
+     * Uses iterative-deepening A* (IDA*) with the Manhattan distance plus linear conflict heuristic, with additive PatternDatabase tables, or with WalkingDistance tables.
+     * Tiles are moved and moved back in place on a small internal board instead of copying a Grid at every node.
+     * With more than one thread, each iteration is split into subtrees that idle threads steal from each other; the solution is still optimal.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    namespace Solver
+    {
+        typedef std::vector<std::uint8_t> moves_t;///<A list of tiles to slide (see GridHelp::swapTile), in order
+
+        /** \brief The outcome of Solver::solve
+         *
+         * \author John Jekel
+         * \date 2018-2018
+         */
+        struct Result
+        {
+            moves_t moves {};                   ///<The tiles to slide to reach Grid::GOAL_GRID, in order
+            std::uint64_t nodesExpanded {0};    ///<How many boards the search looked at
+        };
+
+        Result solve(const Grid &grid, const std::size_t threads = 1);
+        Result solve(const Grid &grid, const PatternDatabase &database, const std::size_t threads = 1);
+        Result solve(const Grid &grid, const WalkingDistance &tables, const std::size_t threads = 1);
+
+        std::uint_fast32_t manhattanDistance(const Grid &grid);
+        std::uint_fast32_t linearConflict(const Grid &grid);
+    }
+}
+#endif //SOLVER_H
@@ -0,0 +1,115 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/ValidatedGrid.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    /* Setup */
+    ///Creates a new ValidatedGrid set to Grid::GOAL_GRID
+    ValidatedGrid::ValidatedGrid() : grid {Grid::GOAL_GRID}
+    {
+        GridHelp::reIndex(grid);
+    }
+
+    /** \brief Creates a new ValidatedGrid from a Grid
+     *
+     * \param newGrid The Grid to copy
+     * \throw std::invalid_argument If the Grid is not valid (index and/or grid array)
+     */
+    ValidatedGrid::ValidatedGrid(const Grid &newGrid)
+    {
+        GridHelp::safeCopy(newGrid, grid);
+    }
+
+    /** \brief Creates a new ValidatedGrid from a grid array, making a new index
+     *
+     * \param newGridArray The grid array to copy
+     * \throw std::invalid_argument If the grid array is not valid
+     */
+    ValidatedGrid::ValidatedGrid(const Grid::gridArray_t &newGridArray)
+    {
+        GridHelp::safeCopy(newGridArray, grid);
+    }
+
+    ///Gets the Grid; it can be read but only changed through the ValidatedGrid
+    const Grid &ValidatedGrid::getGrid() const noexcept
+    {
+        return grid;
+    }
+
+
+    /* Moves */
+    /** \brief Checks if a tile can be swapped with the no tile
+     *
+     * \param tileNum The tile to check
+     * \return If swapping the tile would work (true) or not (false)
+     */
+    bool ValidatedGrid::validMove(const std::uint8_t tileNum) const noexcept
+    {
+        return GridHelp::validMoveUnchecked(tileNum, grid);
+    }
+
+    /** \brief Swaps a tile with the no tile if it can be
+     *
+     * \param tileNum The tile to swap
+     * \return If the tile was swapped (true) or the move was not valid (false)
+     */
+    bool ValidatedGrid::swapTile(const std::uint8_t tileNum) noexcept
+    {
+        if (GridHelp::validMoveUnchecked(tileNum, grid))
+        {
+            GridHelp::swapTileUnchecked(tileNum, grid);
+            return true;
+        }
+        else
+            return false;
+    }
+
+    /** \brief Swaps a tile with the no tile without checking the move
+     *
+     * \param tileNum The tile to swap; must be next to the no tile (see ValidatedGrid::validMove), or the Grid stops being valid
+     */
+    void ValidatedGrid::swapTileUnchecked(const std::uint8_t tileNum) noexcept
+    {
+        GridHelp::swapTileUnchecked(tileNum, grid);
+    }
+
+    /** \brief Checks if the Grid is won
+     *
+     * \return If the grid array is equal to Grid::GOAL_GRID
+     */
+    bool ValidatedGrid::hasWon() const noexcept
+    {
+        return GridHelp::hasWonUnchecked(grid);
+    }
+}
@@ -0,0 +1,66 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef VALIDATEDGRID_H
+#define VALIDATEDGRID_H
+
+
+#include "Grid15/Grid.h"
+
+#include <cstdint>
+
+
+namespace Grid15
+{
+    /** \class ValidatedGrid
+     *
+     * \brief A Grid that is checked once when it is made, so moves on it never need to check it again
+     *
+     * GridHelp::swapTile and friends check the whole grid array on every call, which is most of their cost.
+     * A ValidatedGrid only hands out a const Grid, and only changes it with valid moves, so it stays valid and
+     * can use the unchecked GridHelp functions; none of its moves throw.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class ValidatedGrid
+    {
+        public:
+            /* Setup */
+            ValidatedGrid();
+            explicit ValidatedGrid(const Grid &newGrid);
+            explicit ValidatedGrid(const Grid::gridArray_t &newGridArray);
+
+            const Grid &getGrid() const noexcept;
+
+
+            /* Moves */
+            bool validMove(const std::uint8_t tileNum) const noexcept;
+            bool swapTile(const std::uint8_t tileNum) noexcept;
+            void swapTileUnchecked(const std::uint8_t tileNum) noexcept;
+            bool hasWon() const noexcept;
+
+        private:
+            Grid grid {};///<The Grid, always valid
+    };
+}
+#endif //VALIDATEDGRID_H
@@ -0,0 +1,231 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "Grid15/WalkingDistance.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <exception>
+#include <stdexcept>
+
+
+namespace Grid15
+{
+    namespace
+    {
+        typedef std::array<std::array<std::uint8_t, 4>, 4> counts_t;///<How many tiles in [line] belong in goal line [line]
+
+        /** \brief Packs a summary into one number, 3 bits per count and 2 bits for the no tile's line
+         *
+         * \param counts The counts
+         * \param blankLine The no tile's line
+         * \return The packed summary
+         */
+        std::uint64_t pack(const counts_t &counts, const std::uint_fast32_t blankLine)
+        {
+            std::uint64_t key {static_cast<std::uint64_t> (blankLine) << 48};
+
+            for (std::uint_fast32_t i {0}; i < 4; ++i)
+                for (std::uint_fast32_t j {0}; j < 4; ++j)
+                    key |= static_cast<std::uint64_t> (counts[i][j]) << (3 * ((i * 4) + j));
+
+            return key;
+        }
+
+        /** \brief The reverse of pack
+         *
+         * \param key The packed summary
+         * \param counts Set to the counts
+         * \return The no tile's line
+         */
+        std::uint_fast32_t unpack(const std::uint64_t key, counts_t &counts)
+        {
+            for (std::uint_fast32_t i {0}; i < 4; ++i)
+                for (std::uint_fast32_t j {0}; j < 4; ++j)
+                    counts[i][j] = static_cast<std::uint8_t> ((key >> (3 * ((i * 4) + j))) & 0x7);
+
+            return static_cast<std::uint_fast32_t> (key >> 48);
+        }
+    }
+
+    /* Setup */
+    /** \brief Builds the tables with a breadth first search from the goal summary
+     *
+     * Rows and colums share the tables: in Grid::GOAL_GRID, either way the first 3 lines each hold their 4 tiles and the last holds 3 tiles and the no tile.
+     */
+    WalkingDistance::WalkingDistance()
+    {
+        counts_t counts {};
+        for (std::uint_fast32_t i {0}; i < 4; ++i)
+            counts[i][i] = {4};
+        counts[3][3] = {3};
+
+        std::vector<std::uint64_t> keys {pack(counts, 3)};//doubles as the search queue, since states are numbered in the order they are found
+        states[keys.front()] = {0};
+        distances.push_back(0);
+
+        for (std::size_t i {0}; i < keys.size(); ++i)
+        {
+            const std::uint_fast32_t blankLine {unpack(keys[i], counts)};
+            links.emplace_back();
+            links.back().fill(NO_STATE);
+
+            for (std::uint_fast32_t forward {0}; forward < 2; ++forward)
+            {
+                //the no tile swaps with a tile from the line before or after it
+                if ((!forward && blankLine == 0) || (forward && blankLine == 3))
+                    continue;
+
+                const std::uint_fast32_t otherLine {forward ? blankLine + 1 : blankLine - 1};
+
+                for (std::uint_fast32_t goalLine {0}; goalLine < 4; ++goalLine)
+                {
+                    if (counts[otherLine][goalLine] == 0)
+                        continue;
+
+                    --counts[otherLine][goalLine];
+                    ++counts[blankLine][goalLine];
+
+                    const std::uint64_t newKey {pack(counts, otherLine)};
+                    const auto found {states.find(newKey)};
+
+                    if (found == states.end())
+                    {
+                        states[newKey] = static_cast<state_t> (keys.size());
+                        links[i][(forward * 4) + goalLine] = static_cast<state_t> (keys.size());
+
+                        keys.push_back(newKey);
+                        distances.push_back(static_cast<std::uint8_t> (distances[i] + 1));
+                    }
+                    else
+                        links[i][(forward * 4) + goalLine] = {found->second};
+
+                    ++counts[otherLine][goalLine];
+                    --counts[blankLine][goalLine];
+                }
+            }
+        }
+    }
+
+
+    /* Lookups */
+    /** \brief Finds the walking distance of a Grid
+     *
+     * \param grid The Grid to use
+     * \return The moves needed by the rows plus the moves needed by the colums
+     * \throw std::invalid_argument If the Grid is not valid (index and/or grid array)
+     */
+    std::uint_fast32_t WalkingDistance::estimate(const Grid &grid) const
+    {
+        if (GridHelp::validGrid(grid))
+        {
+            cells_t cells {};
+
+            for (std::uint_fast32_t tile {0}; tile < 16; ++tile)
+                cells[tile] = static_cast<std::uint8_t> ((grid.index[tile][0] * 4) + grid.index[tile][1]);
+
+            return distances[rowState(cells)] + distances[columState(cells)];
+        }
+        else
+            throw std::invalid_argument {"Grid invalid!"};
+    }
+
+    /** \brief Finds the row summary of a board
+     *
+     * \param cells The cell of each tile
+     * \return The summary
+     */
+    WalkingDistance::state_t WalkingDistance::rowState(const cells_t &cells) const
+    {
+        return findState(cells, false);
+    }
+
+    /** \brief Finds the colum summary of a board
+     *
+     * \param cells The cell of each tile
+     * \return The summary
+     */
+    WalkingDistance::state_t WalkingDistance::columState(const cells_t &cells) const
+    {
+        return findState(cells, true);
+    }
+
+    /** \brief Finds a row or colum summary
+     *
+     * \param cells The cell of each tile
+     * \param colums Summarize colums instead of rows
+     * \return The summary
+     */
+    WalkingDistance::state_t WalkingDistance::findState(const cells_t &cells, const bool colums) const
+    {
+        counts_t counts {};
+
+        for (std::uint_fast32_t tile {1}; tile < 16; ++tile)
+        {
+            if (colums)
+                ++counts[cells[tile] % 4][(tile - 1) % 4];
+            else
+                ++counts[cells[tile] / 4][(tile - 1) / 4];
+        }
+
+        return states.at(pack(counts, colums ? (cells[Grid::NO_TILE] % 4) : (cells[Grid::NO_TILE] / 4)));//every summary of a valid board is in the tables
+    }
+
+    /** \brief Finds the summary after a move
+     *
+     * For rows, a tile sliding down moves the no tile back (up); for colums, a tile sliding right moves the no tile back (left)
+     *
+     * \param state The summary before the move
+     * \param forward If the no tile moves forward (down or right) instead of back
+     * \param line The goal row (or colum) of the tile that slides
+     * \return The summary after the move, or WalkingDistance::NO_STATE if it is impossible
+     */
+    WalkingDistance::state_t WalkingDistance::slide(const state_t state, const bool forward, const std::uint8_t line) const
+    {
+        return links[state][(forward ? 4 : 0) + line];
+    }
+
+    /** \brief Gets the moves needed for a summary
+     *
+     * \param state The summary
+     * \return The moves the rows (or colums) need
+     */
+    std::uint8_t WalkingDistance::distance(const state_t state) const
+    {
+        return distances[state];
+    }
+
+
+    /* Information */
+    ///Gets the number of different summaries (24964)
+    std::size_t WalkingDistance::stateCount() const
+    {
+        return distances.size();
+    }
+}
@@ -0,0 +1,86 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef WALKINGDISTANCE_H
+#define WALKINGDISTANCE_H
+
+
+#include "Grid15/Grid.h"
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <unordered_map>
+
+
+namespace Grid15
+{
+    /** \class WalkingDistance
+     *
+     * \brief Tables for the walking distance heuristic, a stronger replacement for Manhattan distance that needs much less memory than a PatternDatabase
+     *
+     * Looking only at rows, a board is summarized by how many tiles in each row belong in each goal row, plus the no tile's row.
+     * A breadth first search over those summaries finds how many up/down moves each one needs; since tiles in the same row get in each other's way,
+     * this is often more than their vertical Manhattan distance. Colums work the same way, and the two are added together.
+     *
+     * There are only 24964 summaries, so the tables take a few hundred KB and are built in a few milliseconds.
+     * Every summary has a link to the summary after each possible move, so the estimate is updated in O(1) per move.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class WalkingDistance
+    {
+        public:
+            /* Typedefs */
+            typedef std::uint16_t state_t;///<The number of a row or colum summary
+            typedef std::array<std::uint8_t, 16> cells_t;///<The cell of each tile from 0 to 15 (cell == (y * 4) + x), like a single dimentional Grid::index
+
+
+            /* Setup */
+            WalkingDistance();
+
+
+            /* Lookups */
+            std::uint_fast32_t estimate(const Grid &grid) const;
+
+            state_t rowState(const cells_t &cells) const;
+            state_t columState(const cells_t &cells) const;
+
+            state_t slide(const state_t state, const bool forward, const std::uint8_t line) const;
+            std::uint8_t distance(const state_t state) const;
+
+
+            /* Information */
+            std::size_t stateCount() const;
+
+            static constexpr state_t NO_STATE {0xFFFF};///<What WalkingDistance::slide gives for impossible moves
+
+        private:
+            std::vector<std::array<state_t, 8>> links {};           ///<The summary after the no tile moves back ([0 to 3]) or forward ([4 to 7]) swapping with a tile belonging in line [0 to 3]
+            std::vector<std::uint8_t> distances {};                 ///<The moves needed for each summary
+            std::unordered_map<std::uint64_t, state_t> states {};   ///<The number of each packed summary
+
+            state_t findState(const cells_t &cells, const bool colums) const;
+    };
+}
+#endif //WALKINGDISTANCE_H
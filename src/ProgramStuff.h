@@ -149,6 +149,7 @@ namespace ProgramStuff
     //FIXME changing this will not effect the graphical checkbox in the options of GTKSlide
     //the menuBar.glade file must be changed to inactive as well
     constexpr bool AUTOSAVE_ON_SLIDE_DEFAULT {true};///<To autosave after each slide by default or not
+    constexpr bool JOURNAL_AUTOSAVE_DEFAULT {true};///<To autosave by journaling moves (see Grid15::MoveJournal) rather than rewriting the save file
 
 
     #ifndef __SLIDEWINDOWS
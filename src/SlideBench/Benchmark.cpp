@@ -0,0 +1,178 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "SlideBench/Benchmark.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+
+
+namespace SlideBench
+{
+    namespace
+    {
+        volatile std::uint64_t sink {0};///<Where results go so the compiler cannot skip the work that made them
+
+        /** \brief Times one repetition
+         *
+         * \param operation The operation
+         * \param ops How many times to do it
+         * \return The time in seconds
+         */
+        double timeRep(const Benchmark::operation_t &operation, const std::uint64_t ops)
+        {
+            const auto start {std::chrono::steady_clock::now()};
+            operation(ops);
+            const std::chrono::duration<double> time {std::chrono::steady_clock::now() - start};
+
+            return time.count();
+        }
+
+        /** \brief Finds a percentile of sorted samples by nearest rank
+         *
+         * \param sorted The samples, smallest first; must not be empty
+         * \param percent The percentile from 0 to 100
+         * \return The sample
+         */
+        double percentile(const std::vector<double> &sorted, const double percent)
+        {
+            const std::size_t rank {static_cast<std::size_t> ((percent / 100.0) * static_cast<double> (sorted.size() - 1) + 0.5)};
+            return sorted[std::min(rank, sorted.size() - 1)];
+        }
+    }
+
+    /** \brief Keeps a result alive so the work that made it is not optimized away
+     *
+     * \param value The result
+     */
+    void keep(const std::uint64_t value)
+    {
+        sink = {sink + value};
+    }
+
+    /** \brief Creates a Benchmark
+     *
+     * \param newRepetitions How many repetitions to time
+     * \param newWarmupSeconds How long to run each operation before timing it
+     * \param newTargetRepTime How long each repetition should take, in seconds
+     */
+    Benchmark::Benchmark(const std::size_t newRepetitions, const double newWarmupSeconds, const double newTargetRepTime) :
+        repetitions {std::max<std::size_t> (newRepetitions, 1)}, warmupSeconds {newWarmupSeconds}, targetRepTime {newTargetRepTime} {}
+
+    /** \brief Warms up and times an operation
+     *
+     * \param name The name to report
+     * \param operation The operation
+     * \return The timings
+     */
+    Measurement Benchmark::run(const std::string &name, const operation_t &operation) const
+    {
+        //warm up, doubling the operations per repetition until a repetition takes long enough
+        std::uint64_t ops {1};
+        double warmedUp {0};
+
+        while (true)
+        {
+            const double time {timeRep(operation, ops)};
+            warmedUp += time;
+
+            if (time < targetRepTime)
+                ops *= 2;
+            else if (warmedUp >= warmupSeconds)
+                break;
+        }
+
+        std::vector<double> samples(repetitions);
+
+        for (double &sample : samples)
+            sample = {(timeRep(operation, ops) * 1e9) / static_cast<double> (ops)};
+
+        std::sort(std::begin(samples), std::end(samples));
+
+        Measurement measurement {};
+        measurement.name = {name};
+        measurement.repetitions = {repetitions};
+        measurement.opsPerRep = {ops};
+        measurement.minNs = {samples.front()};
+        measurement.medianNs = {percentile(samples, 50)};
+        measurement.p90Ns = {percentile(samples, 90)};
+        measurement.p99Ns = {percentile(samples, 99)};
+        measurement.maxNs = {samples.back()};
+        measurement.meanNs = {std::accumulate(std::begin(samples), std::end(samples), 0.0) / static_cast<double> (samples.size())};
+        measurement.opsPerSecond = {1e9 / measurement.medianNs};
+
+        return measurement;
+    }
+
+    /** \brief Prints the header of the human readable table
+     *
+     * \param output Where to print
+     */
+    void Benchmark::printTableHeader(std::ostream &output)
+    {
+        output << std::left << std::setw(26) << "benchmark" << std::right;
+        output << std::setw(12) << "ns/op" << std::setw(14) << "ops/s" << std::setw(12) << "min" << std::setw(12) << "p90" << std::setw(12) << "p99" << "\n";
+    }
+
+    /** \brief Prints a row of the human readable table
+     *
+     * \param output Where to print
+     * \param measurement The timings
+     */
+    void Benchmark::printTableRow(std::ostream &output, const Measurement &measurement)
+    {
+        output << std::left << std::setw(26) << measurement.name << std::right << std::fixed << std::setprecision(2);
+        output << std::setw(12) << measurement.medianNs << std::setw(14) << std::setprecision(0) << measurement.opsPerSecond << std::setprecision(2);
+        output << std::setw(12) << measurement.minNs << std::setw(12) << measurement.p90Ns << std::setw(12) << measurement.p99Ns << "\n";
+        output << std::defaultfloat;
+    }
+
+    /** \brief Prints the header of the CSV output
+     *
+     * \param output Where to print
+     */
+    void Benchmark::printCsvHeader(std::ostream &output)
+    {
+        output << "name,repetitions,ops_per_rep,min_ns,median_ns,p90_ns,p99_ns,max_ns,mean_ns,ops_per_second" << "\n";
+    }
+
+    /** \brief Prints a row of the CSV output
+     *
+     * \param output Where to print
+     * \param measurement The timings
+     */
+    void Benchmark::printCsvRow(std::ostream &output, const Measurement &measurement)
+    {
+        output << measurement.name << "," << measurement.repetitions << "," << measurement.opsPerRep << ",";
+        output << measurement.minNs << "," << measurement.medianNs << "," << measurement.p90Ns << "," << measurement.p99Ns << ",";
+        output << measurement.maxNs << "," << measurement.meanNs << "," << measurement.opsPerSecond << "\n";
+    }
+}
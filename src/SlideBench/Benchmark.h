@@ -0,0 +1,94 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+
+
+/** \namespace SlideBench
+ *
+ * \brief The microbenchmarks for Grid15 (15Slide-bench)
+ *
+ * \author John Jekel
+ * \date 2018-2018
+*/
+namespace SlideBench
+{
+    /** \brief The timings of one benchmark
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    struct Measurement
+    {
+        std::string name {};            ///<The name of the benchmark
+        std::size_t repetitions {0};    ///<How many timed repetitions there were
+        std::uint64_t opsPerRep {0};    ///<How many operations each repetition did
+        double minNs {0};               ///<The fastest repetition, in nanoseconds per operation
+        double medianNs {0};            ///<The median repetition, in nanoseconds per operation
+        double p90Ns {0};               ///<The 90th percentile repetition, in nanoseconds per operation
+        double p99Ns {0};               ///<The 99th percentile repetition, in nanoseconds per operation
+        double maxNs {0};               ///<The slowest repetition, in nanoseconds per operation
+        double meanNs {0};              ///<The mean of all repetitions, in nanoseconds per operation
+        double opsPerSecond {0};        ///<Operations per second, from the median
+    };
+
+    /** \class Benchmark
+     *
+     * \brief Times small operations with warmup, repetitions and percentiles
+     *
+     * An operation is given as a function that does it a number of times in a loop. The number is picked during warmup so
+     * each repetition takes about Benchmark::targetRepTime, which keeps the clock's overhead out of the numbers.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class Benchmark
+    {
+        public:
+            typedef std::function<void(std::uint64_t)> operation_t;///<Does the operation being timed the given number of times
+
+            Benchmark(const std::size_t newRepetitions = 50, const double newWarmupSeconds = 0.1, const double newTargetRepTime = 0.01);
+
+            Measurement run(const std::string &name, const operation_t &operation) const;
+
+            static void printTableHeader(std::ostream &output);
+            static void printTableRow(std::ostream &output, const Measurement &measurement);
+            static void printCsvHeader(std::ostream &output);
+            static void printCsvRow(std::ostream &output, const Measurement &measurement);
+
+        private:
+            std::size_t repetitions {50};   ///<How many repetitions to time
+            double warmupSeconds {0.1};     ///<How long to run before timing
+            double targetRepTime {0.01};    ///<How long each repetition should take, in seconds
+    };
+
+    void keep(const std::uint64_t value);
+}
+#endif //BENCHMARK_H
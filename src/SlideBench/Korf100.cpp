@@ -0,0 +1,289 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "SlideBench/Korf100.h"
+
+#include "ProgramStuff.h"
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/Solver.h"
+
+#include <cstdint>
+#include <string>
+#include <array>
+#include <functional>
+#include <ostream>
+#include <iomanip>
+#include <chrono>
+
+#if !defined(__SLIDEWINDOWS)
+    #include <sys/resource.h>
+#endif
+
+
+namespace SlideBench
+{
+    const std::array<KorfInstance, 100> KORF_100
+    {
+        {
+            {{{14, 13, 15,  7, 11, 12,  9,  5,  6,  0,  2,  1,  4,  8, 10,  3}}, 57},//1
+            {{{13,  5,  4, 10,  9, 12,  8, 14,  2,  3,  7,  1,  0, 15, 11,  6}}, 55},//2
+            {{{14,  7,  8,  2, 13, 11, 10,  4,  9, 12,  5,  0,  3,  6,  1, 15}}, 59},//3
+            {{{ 5, 12, 10,  7, 15, 11, 14,  0,  8,  2,  1, 13,  3,  4,  9,  6}}, 56},//4
+            {{{ 4,  7, 14, 13, 10,  3,  9, 12, 11,  5,  6, 15,  1,  2,  8,  0}}, 56},//5
+            {{{14,  7,  1,  9, 12,  3,  6, 15,  8, 11,  2,  5, 10,  0,  4, 13}}, 52},//6
+            {{{ 2, 11, 15,  5, 13,  4,  6,  7, 12,  8, 10,  1,  9,  3, 14,  0}}, 52},//7
+            {{{12, 11, 15,  3,  8,  0,  4,  2,  6, 13,  9,  5, 14,  1, 10,  7}}, 50},//8
+            {{{ 3, 14,  9, 11,  5,  4,  8,  2, 13, 12,  6,  7, 10,  1, 15,  0}}, 46},//9
+            {{{13, 11,  8,  9,  0, 15,  7, 10,  4,  3,  6, 14,  5, 12,  2,  1}}, 59},//10
+            {{{ 5,  9, 13, 14,  6,  3,  7, 12, 10,  8,  4,  0, 15,  2, 11,  1}}, 57},//11
+            {{{14,  1,  9,  6,  4,  8, 12,  5,  7,  2,  3,  0, 10, 11, 13, 15}}, 45},//12
+            {{{ 3,  6,  5,  2, 10,  0, 15, 14,  1,  4, 13, 12,  9,  8, 11,  7}}, 46},//13
+            {{{ 7,  6,  8,  1, 11,  5, 14, 10,  3,  4,  9, 13, 15,  2,  0, 12}}, 59},//14
+            {{{13, 11,  4, 12,  1,  8,  9, 15,  6,  5, 14,  2,  7,  3, 10,  0}}, 62},//15
+            {{{ 1,  3,  2,  5, 10,  9, 15,  6,  8, 14, 13, 11, 12,  4,  7,  0}}, 42},//16
+            {{{15, 14,  0,  4, 11,  1,  6, 13,  7,  5,  8,  9,  3,  2, 10, 12}}, 66},//17
+            {{{ 6,  0, 14, 12,  1, 15,  9, 10, 11,  4,  7,  2,  8,  3,  5, 13}}, 55},//18
+            {{{ 7, 11,  8,  3, 14,  0,  6, 15,  1,  4, 13,  9,  5, 12,  2, 10}}, 46},//19
+            {{{ 6, 12, 11,  3, 13,  7,  9, 15,  2, 14,  8, 10,  4,  1,  5,  0}}, 52},//20
+            {{{12,  8, 14,  6, 11,  4,  7,  0,  5,  1, 10, 15,  3, 13,  9,  2}}, 54},//21
+            {{{14,  3,  9,  1, 15,  8,  4,  5, 11,  7, 10, 13,  0,  2, 12,  6}}, 59},//22
+            {{{10,  9,  3, 11,  0, 13,  2, 14,  5,  6,  4,  7,  8, 15,  1, 12}}, 49},//23
+            {{{ 7,  3, 14, 13,  4,  1, 10,  8,  5, 12,  9, 11,  2, 15,  6,  0}}, 54},//24
+            {{{11,  4,  2,  7,  1,  0, 10, 15,  6,  9, 14,  8,  3, 13,  5, 12}}, 52},//25
+            {{{ 5,  7,  3, 12, 15, 13, 14,  8,  0, 10,  9,  6,  1,  4,  2, 11}}, 58},//26
+            {{{14,  1,  8, 15,  2,  6,  0,  3,  9, 12, 10, 13,  4,  7,  5, 11}}, 53},//27
+            {{{13, 14,  6, 12,  4,  5,  1,  0,  9,  3, 10,  2, 15, 11,  8,  7}}, 52},//28
+            {{{ 9,  8,  0,  2, 15,  1,  4, 14,  3, 10,  7,  5, 11, 13,  6, 12}}, 54},//29
+            {{{12, 15,  2,  6,  1, 14,  4,  8,  5,  3,  7,  0, 10, 13,  9, 11}}, 47},//30
+            {{{12,  8, 15, 13,  1,  0,  5,  4,  6,  3,  2, 11,  9,  7, 14, 10}}, 50},//31
+            {{{14, 10,  9,  4, 13,  6,  5,  8,  2, 12,  7,  0,  1,  3, 11, 15}}, 59},//32
+            {{{14,  3,  5, 15, 11,  6, 13,  9,  0, 10,  2, 12,  4,  1,  7,  8}}, 60},//33
+            {{{ 6, 11,  7,  8, 13,  2,  5,  4,  1, 10,  3,  9, 14,  0, 12, 15}}, 52},//34
+            {{{ 1,  6, 12, 14,  3,  2, 15,  8,  4,  5, 13,  9,  0,  7, 11, 10}}, 55},//35
+            {{{12,  6,  0,  4,  7,  3, 15,  1, 13,  9,  8, 11,  2, 14,  5, 10}}, 52},//36
+            {{{ 8,  1,  7, 12, 11,  0, 10,  5,  9, 15,  6, 13, 14,  2,  3,  4}}, 58},//37
+            {{{ 7, 15,  8,  2, 13,  6,  3, 12, 11,  0,  4, 10,  9,  5,  1, 14}}, 53},//38
+            {{{ 9,  0,  4, 10,  1, 14, 15,  3, 12,  6,  5,  7, 11, 13,  8,  2}}, 49},//39
+            {{{11,  5,  1, 14,  4, 12, 10,  0,  2,  7, 13,  3,  9, 15,  6,  8}}, 54},//40
+            {{{ 8, 13, 10,  9, 11,  3, 15,  6,  0,  1,  2, 14, 12,  5,  4,  7}}, 54},//41
+            {{{ 4,  5,  7,  2,  9, 14, 12, 13,  0,  3,  6, 11,  8,  1, 15, 10}}, 42},//42
+            {{{11, 15, 14, 13,  1,  9, 10,  4,  3,  6,  2, 12,  7,  5,  8,  0}}, 64},//43
+            {{{12,  9,  0,  6,  8,  3,  5, 14,  2,  4, 11,  7, 10,  1, 15, 13}}, 50},//44
+            {{{ 3, 14,  9,  7, 12, 15,  0,  4,  1,  8,  5,  6, 11, 10,  2, 13}}, 51},//45
+            {{{ 8,  4,  6,  1, 14, 12,  2, 15, 13, 10,  9,  5,  3,  7,  0, 11}}, 49},//46
+            {{{ 6, 10,  1, 14, 15,  8,  3,  5, 13,  0,  2,  7,  4,  9, 11, 12}}, 47},//47
+            {{{ 8, 11,  4,  6,  7,  3, 10,  9,  2, 12, 15, 13,  0,  1,  5, 14}}, 49},//48
+            {{{10,  0,  2,  4,  5,  1,  6, 12, 11, 13,  9,  7, 15,  3, 14,  8}}, 59},//49
+            {{{12,  5, 13, 11,  2, 10,  0,  9,  7,  8,  4,  3, 14,  6, 15,  1}}, 53},//50
+            {{{10,  2,  8,  4, 15,  0,  1, 14, 11, 13,  3,  6,  9,  7,  5, 12}}, 56},//51
+            {{{10,  8,  0, 12,  3,  7,  6,  2,  1, 14,  4, 11, 15, 13,  9,  5}}, 56},//52
+            {{{14,  9, 12, 13, 15,  4,  8, 10,  0,  2,  1,  7,  3, 11,  5,  6}}, 64},//53
+            {{{12, 11,  0,  8, 10,  2, 13, 15,  5,  4,  7,  3,  6,  9, 14,  1}}, 56},//54
+            {{{13,  8, 14,  3,  9,  1,  0,  7, 15,  5,  4, 10, 12,  2,  6, 11}}, 41},//55
+            {{{ 3, 15,  2,  5, 11,  6,  4,  7, 12,  9,  1,  0, 13, 14, 10,  8}}, 55},//56
+            {{{ 5, 11,  6,  9,  4, 13, 12,  0,  8,  2, 15, 10,  1,  7,  3, 14}}, 50},//57
+            {{{ 5,  0, 15,  8,  4,  6,  1, 14, 10, 11,  3,  9,  7, 12,  2, 13}}, 51},//58
+            {{{15, 14,  6,  7, 10,  1,  0, 11, 12,  8,  4,  9,  2,  5, 13,  3}}, 57},//59
+            {{{11, 14, 13,  1,  2,  3, 12,  4, 15,  7,  9,  5, 10,  6,  8,  0}}, 66},//60
+            {{{ 6, 13,  3,  2, 11,  9,  5, 10,  1,  7, 12, 14,  8,  4,  0, 15}}, 45},//61
+            {{{ 4,  6, 12,  0, 14,  2,  9, 13, 11,  8,  3, 15,  7, 10,  1,  5}}, 57},//62
+            {{{ 8, 10,  9, 11, 14,  1,  7, 15, 13,  4,  0, 12,  6,  2,  5,  3}}, 56},//63
+            {{{ 5,  2, 14,  0,  7,  8,  6,  3, 11, 12, 13, 15,  4, 10,  9,  1}}, 51},//64
+            {{{ 7,  8,  3,  2, 10, 12,  4,  6, 11, 13,  5, 15,  0,  1,  9, 14}}, 47},//65
+            {{{11,  6, 14, 12,  3,  5,  1, 15,  8,  0, 10, 13,  9,  7,  4,  2}}, 61},//66
+            {{{ 7,  1,  2,  4,  8,  3,  6, 11, 10, 15,  0,  5, 14, 12, 13,  9}}, 50},//67
+            {{{ 7,  3,  1, 13, 12, 10,  5,  2,  8,  0,  6, 11, 14, 15,  4,  9}}, 51},//68
+            {{{ 6,  0,  5, 15,  1, 14,  4,  9,  2, 13,  8, 10, 11, 12,  7,  3}}, 53},//69
+            {{{15,  1,  3, 12,  4,  0,  6,  5,  2,  8, 14,  9, 13, 10,  7, 11}}, 52},//70
+            {{{ 5,  7,  0, 11, 12,  1,  9, 10, 15,  6,  2,  3,  8,  4, 13, 14}}, 44},//71
+            {{{12, 15, 11, 10,  4,  5, 14,  0, 13,  7,  1,  2,  9,  8,  3,  6}}, 56},//72
+            {{{ 6, 14, 10,  5, 15,  8,  7,  1,  3,  4,  2,  0, 12,  9, 11, 13}}, 49},//73
+            {{{14, 13,  4, 11, 15,  8,  6,  9,  0,  7,  3,  1,  2, 10, 12,  5}}, 56},//74
+            {{{14,  4,  0, 10,  6,  5,  1,  3,  9,  2, 13, 15, 12,  7,  8, 11}}, 48},//75
+            {{{15, 10,  8,  3,  0,  6,  9,  5,  1, 14, 13, 11,  7,  2, 12,  4}}, 57},//76
+            {{{ 0, 13,  2,  4, 12, 14,  6,  9, 15,  1, 10,  3, 11,  5,  8,  7}}, 54},//77
+            {{{ 3, 14, 13,  6,  4, 15,  8,  9,  5, 12, 10,  0,  2,  7,  1, 11}}, 53},//78
+            {{{ 0,  1,  9,  7, 11, 13,  5,  3, 14, 12,  4,  2,  8,  6, 10, 15}}, 42},//79
+            {{{11,  0, 15,  8, 13, 12,  3,  5, 10,  1,  4,  6, 14,  9,  7,  2}}, 57},//80
+            {{{13,  0,  9, 12, 11,  6,  3,  5, 15,  8,  1, 10,  4, 14,  2,  7}}, 53},//81
+            {{{14, 10,  2,  1, 13,  9,  8, 11,  7,  3,  6, 12, 15,  5,  4,  0}}, 62},//82
+            {{{12,  3,  9,  1,  4,  5, 10,  2,  6, 11, 15,  0, 14,  7, 13,  8}}, 49},//83
+            {{{15,  8, 10,  7,  0, 12, 14,  1,  5,  9,  6,  3, 13, 11,  4,  2}}, 55},//84
+            {{{ 4,  7, 13, 10,  1,  2,  9,  6, 12,  8, 14,  5,  3,  0, 11, 15}}, 44},//85
+            {{{ 6,  0,  5, 10, 11, 12,  9,  2,  1,  7,  4,  3, 14,  8, 13, 15}}, 45},//86
+            {{{ 9,  5, 11, 10, 13,  0,  2,  1,  8,  6, 14, 12,  4,  7,  3, 15}}, 52},//87
+            {{{15,  2, 12, 11, 14, 13,  9,  5,  1,  3,  8,  7,  0, 10,  6,  4}}, 65},//88
+            {{{11,  1,  7,  4, 10, 13,  3,  8,  9, 14,  0, 15,  6,  5,  2, 12}}, 54},//89
+            {{{ 5,  4,  7,  1, 11, 12, 14, 15, 10, 13,  8,  6,  2,  0,  9,  3}}, 50},//90
+            {{{ 9,  7,  5,  2, 14, 15, 12, 10, 11,  3,  6,  1,  8, 13,  0,  4}}, 57},//91
+            {{{ 3,  2,  7,  9,  0, 15, 12,  4,  6, 11,  5, 14,  8, 13, 10,  1}}, 57},//92
+            {{{13,  9, 14,  6, 12,  8,  1,  2,  3,  4,  0,  7,  5, 10, 11, 15}}, 46},//93
+            {{{ 5,  7, 11,  8,  0, 14,  9, 13, 10, 12,  3, 15,  6,  1,  4,  2}}, 53},//94
+            {{{ 4,  3,  6, 13,  7, 15,  9,  0, 10,  5,  8, 11,  2, 12,  1, 14}}, 50},//95
+            {{{ 1,  7, 15, 14,  2,  6,  4,  9, 12, 11, 13,  3,  0,  8,  5, 10}}, 49},//96
+            {{{ 9, 14,  5,  7,  8, 15,  1,  2, 10,  4, 13,  6, 12,  0, 11,  3}}, 44},//97
+            {{{ 0, 11,  3, 12,  5,  2,  1,  9,  8, 10, 14, 15,  7,  4, 13,  6}}, 54},//98
+            {{{ 7, 15,  4,  0, 10,  9,  2,  5, 12, 11, 13,  6,  1,  3, 14,  8}}, 57},//99
+            {{{11,  4,  0,  8,  6, 10,  5, 13, 12,  7, 14,  3,  1,  2,  9, 15}}, 54},//100
+        }
+    };
+
+    /** \brief Turns a Korf instance into a Grid with the same optimal solution length
+     *
+     * Turning the board upside down (cell c becomes cell 15 - c) and renaming tile t to 16 - t maps Korf's goal onto Grid::GOAL_GRID
+     * and keeps every move a move, so solution lengths do not change
+     *
+     * \param instance The instance
+     * \return The Grid
+     */
+    Grid15::Grid korfToGrid(const KorfInstance &instance)
+    {
+        Grid15::Grid::gridArray_t gridArray {};
+
+        for (std::size_t cell {0}; cell < 16; ++cell)
+        {
+            const std::uint8_t tile {instance.tiles[cell]};
+            const std::size_t newCell {15 - cell};
+
+            gridArray[newCell / 4][newCell % 4] = static_cast<std::uint8_t> ((tile == Grid15::Grid::NO_TILE) ? Grid15::Grid::NO_TILE : (16 - tile));
+        }
+
+        Grid15::Grid grid {};
+        Grid15::GridHelp::safeCopy(gridArray, grid);
+
+        return grid;
+    }
+
+    /** \brief Prints the header for SlideBench::runKorf100
+     *
+     * \param csv Print the CSV header instead of the table header
+     * \param output Where to print
+     */
+    void printKorfHeader(const bool csv, std::ostream &output)
+    {
+        if (csv)
+            output << "heuristic,instance,length,optimal,nodes,seconds,nodes_per_second,process_peak_rss_kib,peak_rss_growth_kib,status" << "\n";
+        else
+        {
+            output << std::left << std::setw(6) << "heur" << std::right << std::setw(5) << "#" << std::setw(5) << "len" << std::setw(5) << "opt";
+            output << std::setw(14) << "nodes" << std::setw(10) << "seconds" << std::setw(14) << "nodes/s" << "\n";
+        }
+    }
+
+    /** \brief Solves Korf's instances and checks that every solution is optimal
+     *
+     * Prints a row per instance and a total row with the peak memory of the whole process so far. That peak is a high-water
+     * mark for the whole run, so it includes earlier heuristics; the growth column is how much this heuristic raised it
+     *
+     * \param name The name of the heuristic, for the output
+     * \param solver Solves a Grid with the heuristic
+     * \param first The first instance to solve, from 1 to 100
+     * \param last The last instance to solve, from first to 100
+     * \param peakBefore SlideBench::peakMemory from before the heuristic's tables were built
+     * \param csv Print CSV instead of a table
+     * \param output Where to print
+     * \return If every solution had the optimal length and solved its Grid
+     */
+    bool runKorf100(const std::string &name, const solver_t &solver, const std::size_t first, const std::size_t last, const std::uint64_t peakBefore, const bool csv, std::ostream &output)
+    {
+        std::uint64_t totalNodes {0};
+        double totalSeconds {0};
+        std::size_t failures {0};
+
+        for (std::size_t number {first}; number <= last && number <= KORF_100.size(); ++number)
+        {
+            const KorfInstance &instance {KORF_100[number - 1]};
+            const Grid15::Grid grid {korfToGrid(instance)};
+
+            const auto start {std::chrono::steady_clock::now()};
+            const Grid15::Solver::Result result {solver(grid)};
+            const std::chrono::duration<double> time {std::chrono::steady_clock::now() - start};
+
+            //check the moves really solve it, not just that there are the right number of them
+            Grid15::Grid solved {grid};
+            for (std::uint8_t tile : result.moves)
+                Grid15::GridHelp::swapTile(tile, solved);
+
+            const bool optimal {result.moves.size() == instance.optimalLength && Grid15::GridHelp::hasWon(solved)};
+
+            totalNodes += result.nodesExpanded;
+            totalSeconds += time.count();
+            failures += optimal ? 0 : 1;
+
+            if (csv)
+            {
+                output << name << "," << number << "," << result.moves.size() << "," << static_cast<int> (instance.optimalLength) << ",";
+                output << result.nodesExpanded << "," << time.count() << "," << (static_cast<double> (result.nodesExpanded) / time.count()) << ",,," << (optimal ? "ok" : "FAIL") << "\n";
+            }
+            else
+            {
+                output << std::left << std::setw(6) << name << std::right << std::setw(5) << number << std::setw(5) << result.moves.size();
+                output << std::setw(5) << static_cast<int> (instance.optimalLength) << std::setw(14) << result.nodesExpanded;
+                output << std::fixed << std::setprecision(3) << std::setw(10) << time.count() << std::setprecision(0);
+                output << std::setw(14) << (static_cast<double> (result.nodesExpanded) / time.count()) << std::defaultfloat;
+                output << (optimal ? "" : "  NOT OPTIMAL") << "\n";
+            }
+
+            output.flush();
+        }
+
+        const std::uint64_t peak {peakMemory()};
+
+        if (csv)
+        {
+            output << name << ",total,,," << totalNodes << "," << totalSeconds << "," << (static_cast<double> (totalNodes) / totalSeconds) << ",";
+            output << peak << "," << (peak - peakBefore) << "," << (failures ? "FAIL" : "ok") << "\n";
+        }
+        else
+        {
+            output << std::left << std::setw(6) << name << std::right << std::setw(15) << "total" << std::setw(14) << totalNodes;
+            output << std::fixed << std::setprecision(3) << std::setw(10) << totalSeconds << std::setprecision(0);
+            output << std::setw(14) << (static_cast<double> (totalNodes) / totalSeconds) << std::defaultfloat;
+            output << "  process peak RSS " << peak << " KiB (+" << (peak - peakBefore) << " KiB), " << failures << " not optimal" << "\n";
+        }
+
+        return failures == 0;
+    }
+
+    /** \brief Finds the most memory the process has used at once
+     *
+     * \return The peak resident set size in KiB, or 0 if it is not known on this operating system
+     */
+    std::uint64_t peakMemory()
+    {
+        #if defined(__SLIDEWINDOWS)
+        return 0;
+        #else
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+
+        #if defined(__SLIDEMAC)
+        return static_cast<std::uint64_t> (usage.ru_maxrss) / 1024;//bytes on macOS
+        #else
+        return static_cast<std::uint64_t> (usage.ru_maxrss);
+        #endif
+        #endif
+    }
+}
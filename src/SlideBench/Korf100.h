@@ -0,0 +1,61 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef KORF100_H
+#define KORF100_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/Solver.h"
+
+#include <cstdint>
+#include <string>
+#include <array>
+#include <functional>
+#include <ostream>
+
+
+namespace SlideBench
+{
+    /** \brief One of Korf's 100 random 15 puzzle instances, as printed in his 1985 paper
+     *
+     * Korf's goal has the no tile first (0 1 2 ... 15), so the tiles here are not in Grid15 order; see SlideBench::korfToGrid
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    struct KorfInstance
+    {
+        std::array<std::uint8_t, 16> tiles;///<The tiles left to right and top to bottom, with 0 as the no tile
+        std::uint8_t optimalLength;///<The length of an optimal solution
+    };
+
+    extern const std::array<KorfInstance, 100> KORF_100;///<The instances, numbered 1 to 100 in the paper
+
+    typedef std::function<Grid15::Solver::Result(const Grid15::Grid&)> solver_t;///<Solves a Grid with some heuristic
+
+    Grid15::Grid korfToGrid(const KorfInstance &instance);
+    void printKorfHeader(const bool csv, std::ostream &output);
+    bool runKorf100(const std::string &name, const solver_t &solver, const std::size_t first, const std::size_t last, const std::uint64_t peakBefore, const bool csv, std::ostream &output);
+    std::uint64_t peakMemory();
+}
+#endif //KORF100_H
@@ -0,0 +1,359 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "SlideBench/Benchmark.h"
+#include "SlideBench/Korf100.h"
+#include "Grid15/Grid.h"
+#include "Grid15/BasicGrid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/Solver.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <memory>
+#include <exception>
+#include <stdexcept>
+
+
+namespace
+{
+    ///Prints how to use 15Slide-bench
+    void displayUsage()
+    {
+        std::cout << "Usage: 15Slide-bench [options]" << "\n";
+        std::cout << "Times the GridHelp functions that every 15Slide UI calls on each move," << "\n";
+        std::cout << "or with --korf, solves Korf's 100 instances and fails if any solution is not optimal." << "\n";
+        std::cout << "\n";
+        std::cout << "Options:" << "\n";
+        std::cout << "  -c, --csv              Print CSV instead of a table" << "\n";
+        std::cout << "  -r, --repetitions num  Timed repetitions per benchmark (default: 50)" << "\n";
+        std::cout << "  -f, --filter str       Only run benchmarks with names containing str" << "\n";
+        std::cout << "  -k, --korf list        Run the Korf 100 benchmark with each comma separated heuristic: md (Manhattan distance" << "\n";
+        std::cout << "                         and linear conflict), wd (walking distance) and/or pdb (needs --pdb)" << "\n";
+        std::cout << "  -p, --pdb file         The saved pattern database for --korf pdb (make one with 15Slide-solve --build-pdb)" << "\n";
+        std::cout << "  -i, --instances a-b    Only solve Korf instances a to b (default: 1-100)" << "\n";
+        std::cout << "  -s, --search-threads num  Threads each search uses for --korf (default: 1, 0 for all)" << "\n";
+        std::cout << "  -h, --help             Show this" << "\n";
+    }
+
+    /** \brief Makes a closed random walk: a list of valid moves that ends up back where it started
+     *
+     * \param grid The Grid to start from
+     * \param length How many moves to make before walking back
+     * \return The tiles to slide; twice as many as length
+     */
+    std::vector<std::uint8_t> makeWalk(Grid15::Grid grid, const std::size_t length)
+    {
+        std::mt19937 randomEngine {15};
+        std::vector<std::uint8_t> walk {};
+
+        while (walk.size() < length)
+        {
+            const std::uint8_t tile {static_cast<std::uint8_t> ((randomEngine() % Grid15::Grid::TILE_MAX) + 1)};
+
+            if (Grid15::GridHelp::validMove(tile, grid))
+            {
+                Grid15::GridHelp::swapTile(tile, grid);
+                walk.push_back(tile);
+            }
+        }
+
+        //sliding the same tiles in reverse order undoes the walk
+        walk.insert(std::end(walk), walk.rbegin(), walk.rend());
+
+        return walk;
+    }
+
+    /** \brief Makes a benchmark that slides tiles on a Grid15::BasicGrid of any size
+     *
+     * Each move slides one of the first two cells next to the no tile (every cell has at least two), so every move is valid
+     *
+     * \param grid The board to slide tiles on; must outlive the benchmark
+     * \return The benchmark
+     */
+    template <std::size_t Rows, std::size_t Colums>
+    SlideBench::Benchmark::operation_t basicGridSwapTile(Grid15::BasicGrid<Rows, Colums> &grid)
+    {
+        return [&grid](std::uint64_t ops)
+        {
+            typedef Grid15::BasicGrid<Rows, Colums> basicGrid_t;
+
+            for (std::uint64_t i {0}; i < ops; ++i)
+            {
+                const std::uint8_t cell {basicGrid_t::NEIGHBOURS[grid.cellOf(basicGrid_t::layout_t::NO_TILE)][(i / 3) % 2]};
+                grid.swapTile(grid.gridArray[cell / Colums][cell % Colums]);
+            }
+
+            SlideBench::keep(grid.manhattanDistance());
+        };
+    }
+}
+
+
+/** \brief 15Slide-bench main function
+ *
+ * \author John Jekel
+ * \date 2018-2018
+**/
+int main(int argc, char *argv[])
+{
+    try
+    {
+        bool csv {false};
+        std::size_t repetitions {50};
+        std::string filter {};
+        std::string korfList {};
+        std::string databaseFile {};
+        std::size_t firstInstance {1};
+        std::size_t lastInstance {100};
+        std::size_t searchThreads {1};
+
+        const std::vector<std::string> arguments(argv + 1, argv + argc);
+
+        for (std::size_t i {0}; i < arguments.size(); ++i)
+        {
+            const std::string &argument {arguments[i]};
+            const bool hasValue {i + 1 < arguments.size()};
+
+            if (argument == "-h" || argument == "--help")
+            {
+                displayUsage();
+                return 0;
+            }
+            else if (argument == "-c" || argument == "--csv")
+                csv = {true};
+            else if ((argument == "-r" || argument == "--repetitions") && hasValue)
+                repetitions = static_cast<std::size_t> (std::stoul(arguments[++i]));
+            else if ((argument == "-f" || argument == "--filter") && hasValue)
+                filter = {arguments[++i]};
+            else if ((argument == "-k" || argument == "--korf") && hasValue)
+                korfList = {arguments[++i]};
+            else if ((argument == "-p" || argument == "--pdb") && hasValue)
+                databaseFile = {arguments[++i]};
+            else if ((argument == "-i" || argument == "--instances") && hasValue)
+            {
+                char dash {};
+                std::istringstream range {arguments[++i]};
+
+                if (!(range >> firstInstance >> dash >> lastInstance) || dash != '-' || firstInstance < 1 || lastInstance > 100 || firstInstance > lastInstance)
+                {
+                    std::cerr << "15Slide-bench: bad instance range \"" << arguments[i] << "\"" << "\n";
+                    return 2;
+                }
+            }
+            else if ((argument == "-s" || argument == "--search-threads") && hasValue)
+                searchThreads = static_cast<std::size_t> (std::stoul(arguments[++i]));
+            else
+            {
+                std::cerr << "15Slide-bench: bad argument \"" << argument << "\"; try --help" << "\n";
+                return 2;
+            }
+        }
+
+        if (!korfList.empty())
+        {
+            SlideBench::printKorfHeader(csv, std::cout);
+
+            std::istringstream list {korfList};
+            std::string name {};
+            bool allOptimal {true};
+
+            while (std::getline(list, name, ','))
+            {
+                SlideBench::solver_t solver {};
+                const std::uint64_t peakBefore {SlideBench::peakMemory()};//so the tables built below count towards this heuristic
+                std::shared_ptr<Grid15::WalkingDistance> walking {};
+                std::shared_ptr<Grid15::PatternDatabase> database {};
+
+                if (name == "md")
+                    solver = [&](const Grid15::Grid &grid) {return Grid15::Solver::solve(grid, searchThreads);};
+                else if (name == "wd")
+                {
+                    walking.reset(new Grid15::WalkingDistance {});
+                    solver = [&](const Grid15::Grid &grid) {return Grid15::Solver::solve(grid, *walking, searchThreads);};
+                }
+                else if (name == "pdb" && !databaseFile.empty())
+                {
+                    database.reset(new Grid15::PatternDatabase {databaseFile});
+
+                    if (!database->verify())
+                    {
+                        std::cerr << "15Slide-bench: the pattern database " << databaseFile << " is corrupted" << "\n";
+                        return 1;
+                    }
+
+                    solver = [&](const Grid15::Grid &grid) {return Grid15::Solver::solve(grid, *database, searchThreads);};
+                }
+                else
+                {
+                    std::cerr << "15Slide-bench: unknown heuristic \"" << name << "\" (pdb needs --pdb); try --help" << "\n";
+                    return 2;
+                }
+
+                allOptimal = SlideBench::runKorf100(name, solver, firstInstance, lastInstance, peakBefore, csv, std::cout) && allOptimal;
+            }
+
+            return allOptimal ? 0 : 1;
+        }
+
+        //the same boards every run, so results can be compared between builds
+        std::vector<Grid15::Grid> grids {};
+        std::mt19937 randomEngine {15};
+
+        for (std::size_t i {0}; i < 1024; ++i)
+        {
+            Grid15::Grid grid {Grid15::Grid::GOAL_GRID};
+            Grid15::GridHelp::reIndex(grid);
+
+            for (std::size_t move {0}; move < 200; ++move)
+            {
+                const std::uint8_t tile {static_cast<std::uint8_t> ((randomEngine() % Grid15::Grid::TILE_MAX) + 1)};
+
+                if (Grid15::GridHelp::validMove(tile, grid))
+                    Grid15::GridHelp::swapTile(tile, grid);
+            }
+
+            grids.push_back(grid);
+        }
+
+        Grid15::Grid walkGrid {grids.front()};
+        const std::vector<std::uint8_t> walk {makeWalk(walkGrid, 4096)};
+        std::size_t walkStep {0};//where walkGrid is along the walk; kept between repetitions so every move stays valid
+
+        Grid15::BasicGrid<3, 3> grid3x3 {};
+        Grid15::BasicGrid<4, 4> grid4x4 {};
+        Grid15::BasicGrid<5, 5> grid5x5 {};
+        Grid15::BasicGrid<3, 5> grid3x5 {};
+
+        const std::vector<std::pair<std::string, SlideBench::Benchmark::operation_t>> benchmarks
+        {
+            {"validMove", [&](std::uint64_t ops)
+                {
+                    std::uint64_t valid {0};
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        valid += Grid15::GridHelp::validMove(static_cast<std::uint8_t> (i % 16), grids[(i / 16) % grids.size()]);
+                    SlideBench::keep(valid);
+                }
+            },
+            {"validMoveUnchecked", [&](std::uint64_t ops)
+                {
+                    std::uint64_t valid {0};
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        valid += Grid15::GridHelp::validMoveUnchecked(static_cast<std::uint8_t> (i % 16), grids[(i / 16) % grids.size()]);
+                    SlideBench::keep(valid);
+                }
+            },
+            {"swapTile", [&](std::uint64_t ops)
+                {
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        Grid15::GridHelp::swapTile(walk[walkStep++ % walk.size()], walkGrid);
+                    SlideBench::keep(walkGrid.hash);
+                }
+            },
+            {"swapTileUnchecked", [&](std::uint64_t ops)
+                {
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        Grid15::GridHelp::swapTileUnchecked(walk[walkStep++ % walk.size()], walkGrid);
+                    SlideBench::keep(walkGrid.hash);
+                }
+            },
+            {"hasWon", [&](std::uint64_t ops)
+                {
+                    std::uint64_t won {0};
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        won += Grid15::GridHelp::hasWon(grids[i % grids.size()]);
+                    SlideBench::keep(won);
+                }
+            },
+            {"validGridArray", [&](std::uint64_t ops)
+                {
+                    std::uint64_t valid {0};
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        valid += Grid15::GridHelp::validGridArray(grids[i % grids.size()].gridArray);
+                    SlideBench::keep(valid);
+                }
+            },
+            {"reIndex", [&](std::uint64_t ops)
+                {
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        Grid15::GridHelp::reIndex(grids[i % grids.size()]);
+                    SlideBench::keep(grids.front().hash);
+                }
+            },
+            {"solvableGrid", [&](std::uint64_t ops)
+                {
+                    std::uint64_t solvable {0};
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        solvable += Grid15::GridHelp::solvableGrid(grids[i % grids.size()]);
+                    SlideBench::keep(solvable);
+                }
+            },
+            {"generateRandomGrid", [&](std::uint64_t ops)
+                {
+                    std::uint64_t tiles {0};
+                    for (std::uint64_t i {0}; i < ops; ++i)
+                        tiles += Grid15::GridHelp::generateRandomGrid().gridArray[0][0];
+                    SlideBench::keep(tiles);
+                }
+            },
+            {"BasicGrid<3,3>::swapTile", basicGridSwapTile(grid3x3)},
+            {"BasicGrid<4,4>::swapTile", basicGridSwapTile(grid4x4)},
+            {"BasicGrid<5,5>::swapTile", basicGridSwapTile(grid5x5)},
+            {"BasicGrid<3,5>::swapTile", basicGridSwapTile(grid3x5)}
+        };
+
+        const SlideBench::Benchmark benchmark {repetitions};
+
+        if (csv)
+            SlideBench::Benchmark::printCsvHeader(std::cout);
+        else
+            SlideBench::Benchmark::printTableHeader(std::cout);
+
+        for (const auto &entry : benchmarks)
+        {
+            if (entry.first.find(filter) == std::string::npos)
+                continue;
+
+            const SlideBench::Measurement measurement {benchmark.run(entry.first, entry.second)};
+
+            if (csv)
+                SlideBench::Benchmark::printCsvRow(std::cout, measurement);
+            else
+                SlideBench::Benchmark::printTableRow(std::cout, measurement);
+        }
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "15Slide-bench: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,319 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "SlideSolve/BatchSolver.h"
+
+#include "Grid15/Grid.h"
+#include "Grid15/GridHelp.h"
+#include "Grid15/Solver.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+#include "Grid15/Generator.h"
+#include "Grid15/Corpus.h"
+#include "Grid15/BoardList.h"
+
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+
+
+namespace SlideSolve
+{
+    /** \brief Reads boards, one per line (see Grid15::BoardList)
+     *
+     * \param input The stream to read from
+     * \return The boards, including ones that could not be read (see Board::error)
+     */
+    std::vector<Board> readBoards(std::istream &input)
+    {
+        return Grid15::BoardList::read(input);
+    }
+
+    /** \brief Reads boards, one per line, from a file (see Grid15::BoardList)
+     *
+     * \param file The file to read from
+     * \return The boards, including ones that could not be read (see Board::error)
+     * \throw std::ios_base::failure If the file cannot be opened
+     */
+    std::vector<Board> readBoards(const std::string &file)
+    {
+        return Grid15::BoardList::readFile(file);
+    }
+
+    /** \brief Reads every board of a corpus
+     *
+     * Board::line is the record number, counting from 1
+     *
+     * \param corpus The corpus
+     * \return The boards, with an error instead for records that are not valid boards
+     */
+    std::vector<Board> readBoards(const Grid15::Corpus &corpus)
+    {
+        std::vector<Board> boards(corpus.size());
+
+        for (std::size_t i {0}; i < boards.size(); ++i)
+        {
+            boards[i].line = {i + 1};
+
+            try
+            {
+                boards[i].grid = {corpus.at(i).toGrid()};
+            }
+            catch (std::invalid_argument &e)
+            {
+                boards[i].error = {e.what()};
+            }
+        }
+
+        return boards;
+    }
+
+    /** \brief Formats a result as a tab separated row (see BatchSolver::HEADER)
+     *
+     * \param row The result
+     * \return The row, without a newline; the moves are comma separated tiles to slide
+     */
+    std::string formatRow(const Row &row)
+    {
+        std::ostringstream rowStream {};
+
+        rowStream << row.line << "\t";
+
+        if (row.error.empty())
+        {
+            rowStream << row.result.moves.size() << "\t" << row.result.nodesExpanded << "\t" << row.seconds << "\t";
+
+            for (std::size_t i {0}; i < row.result.moves.size(); ++i)
+                rowStream << (i ? "," : "") << static_cast<int> (row.result.moves[i]);
+        }
+        else
+            rowStream << "-\t-\t-\terror: " << row.error;
+
+        return rowStream.str();
+    }
+
+
+    /* BatchSolver */
+    /** \brief Formats a board the way SlideSolve::readBoards reads it
+     *
+     * \param grid The board
+     * \return The 16 tiles in reading order, separated by spaces
+     */
+    std::string formatBoard(const Grid15::Grid &grid)
+    {
+        char line[Grid15::GridHelp::FORMATTED_GRID_SIZE];
+        return {line, Grid15::GridHelp::formatGridArray(grid.gridArray, line)};
+    }
+
+    /** \brief Creates a BatchSolver that uses Manhattan distance and linear conflict
+     *
+     * \param newThreads The number of boards to solve at once; 0 for one per hardware thread
+     * \param newSearchThreads The number of threads each board's search uses; 0 for one per hardware thread
+     */
+    BatchSolver::BatchSolver(const std::size_t newThreads, const std::size_t newSearchThreads) : threads {newThreads}, searchThreads {newSearchThreads}
+    {
+        if (threads == 0)
+            threads = {std::max<std::size_t> (std::thread::hardware_concurrency(), 1)};
+    }
+
+    ///Uses walking distance instead of Manhattan distance and linear conflict
+    void BatchSolver::useWalkingDistance()
+    {
+        walking.reset(new Grid15::WalkingDistance {});
+        database.reset();
+    }
+
+    /** \brief Uses pattern databases instead of Manhattan distance and linear conflict
+     *
+     * The tables are checked in the background while the first boards are solved; if they are corrupted, every board gets an error
+     * instead of a result (see Grid15::Solver::solve)
+     *
+     * \param file The pattern database file, made with Grid15::PatternDatabase::save
+     * \throw std::ios_base::failure If the file cannot be read
+     * \throw std::invalid_argument If the file is not a pattern database
+     */
+    void BatchSolver::usePatternDatabase(const std::string &file)
+    {
+        database.reset(new Grid15::PatternDatabase {file});
+        walking.reset();
+    }
+
+    /** \brief Solves one board
+     *
+     * \param board The board
+     * \return The result, with an error instead if the board could not be read or solved
+     */
+    Row BatchSolver::solve(const Board &board) const
+    {
+        Row row {};
+        row.line = {board.line};
+        row.error = {board.error};
+
+        if (!row.error.empty())
+            return row;
+
+        const auto start {std::chrono::steady_clock::now()};
+
+        try
+        {
+            if (database)
+                row.result = {Grid15::Solver::solve(board.grid, *database, searchThreads)};
+            else if (walking)
+                row.result = {Grid15::Solver::solve(board.grid, *walking, searchThreads)};
+            else
+                row.result = {Grid15::Solver::solve(board.grid, searchThreads)};
+        }
+        catch (std::invalid_argument &e)
+        {
+            row.error = {e.what()};
+        }
+
+        const std::chrono::duration<double> time {std::chrono::steady_clock::now() - start};
+        row.seconds = {time.count()};
+
+        return row;
+    }
+
+    /** \brief Solves boards on a pool of threads
+     *
+     * Rows are written as soon as every board before them is done, so the output is always in input order
+     *
+     * \param boards The boards
+     * \param output Where to write the header and a row for each board
+     */
+    void BatchSolver::solve(const std::vector<Board> &boards, std::ostream &output) const
+    {
+        std::vector<Row> rows(boards.size());
+        std::vector<bool> done(boards.size(), false);
+        std::size_t nextRow {0};//the first row not written yet
+        std::mutex outputMutex {};
+        std::atomic<std::size_t> nextBoard {0};
+
+        output << HEADER << "\n";
+
+        auto work
+        {
+            [&]()
+            {
+                for (std::size_t i {nextBoard++}; i < boards.size(); i = {nextBoard++})
+                {
+                    Row row {solve(boards[i])};
+
+                    std::lock_guard<std::mutex> lock {outputMutex};
+
+                    rows[i] = {std::move(row)};
+                    done[i] = {true};
+
+                    while (nextRow < rows.size() && done[nextRow])
+                    {
+                        output << formatRow(rows[nextRow]) << "\n";
+                        ++nextRow;
+                    }
+
+                    output.flush();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers {};
+
+        for (std::size_t i {1}; i < std::min(threads, boards.size()); ++i)
+            workers.emplace_back(work);
+
+        work();
+
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    /** \brief Makes random boards whose optimal solution length is in a range, using this BatchSolver's heuristic and threads
+     *
+     * See Grid15::Generator::generate
+     *
+     * \param count How many boards to make
+     * \param range The optimal lengths allowed
+     * \return The boards and their lengths; fewer than count if the range is too hard to hit
+     * \throw std::invalid_argument If the range is invalid, or the pattern database is corrupted
+     */
+    std::vector<Grid15::Generator::Puzzle> BatchSolver::generate(const std::size_t count, const Grid15::Generator::Range range) const
+    {
+        if (database)
+            return Grid15::Generator::generate(count, range, *database, threads);
+        else if (walking)
+            return Grid15::Generator::generate(count, range, *walking, threads);
+        else
+            return Grid15::Generator::generate(count, range, threads);
+    }
+
+    /** \brief Makes random boards whose optimal solution length is in a range and writes them as text
+     *
+     * Each board is written on its own line with its length in a comment, so the output can be read back with SlideSolve::readBoards
+     *
+     * \param count How many boards to make
+     * \param range The optimal lengths allowed
+     * \param output Where to write the boards
+     * \return How many boards were made; fewer than count if the range is too hard to hit
+     * \throw std::invalid_argument If the range is invalid, or the pattern database is corrupted
+     */
+    std::size_t BatchSolver::generate(const std::size_t count, const Grid15::Generator::Range range, std::ostream &output) const
+    {
+        const std::vector<Grid15::Generator::Puzzle> puzzles {generate(count, range)};
+
+        for (const Grid15::Generator::Puzzle &puzzle : puzzles)
+            output << formatBoard(puzzle.grid) << "\t# optimal " << static_cast<unsigned int> (puzzle.length) << "\n";
+
+        return puzzles.size();
+    }
+
+    /** \brief Makes random boards whose optimal solution length is in a range and adds them to a corpus, with their lengths
+     *
+     * \param count How many boards to make
+     * \param range The optimal lengths allowed
+     * \param corpus Where to add the boards
+     * \return How many boards were made; fewer than count if the range is too hard to hit
+     * \throw std::invalid_argument If the range is invalid, or the pattern database is corrupted
+     * \throw std::ios_base::failure If the corpus cannot be written
+     */
+    std::size_t BatchSolver::generate(const std::size_t count, const Grid15::Generator::Range range, Grid15::CorpusWriter &corpus) const
+    {
+        const std::vector<Grid15::Generator::Puzzle> puzzles {generate(count, range)};
+
+        for (const Grid15::Generator::Puzzle &puzzle : puzzles)
+            corpus.add(puzzle.grid, puzzle.length);
+
+        return puzzles.size();
+    }
+}
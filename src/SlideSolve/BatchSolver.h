@@ -0,0 +1,107 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#ifndef BATCHSOLVER_H
+#define BATCHSOLVER_H
+
+
+#include "Grid15/Grid.h"
+#include "Grid15/Solver.h"
+#include "Grid15/PatternDatabase.h"
+#include "Grid15/WalkingDistance.h"
+#include "Grid15/Generator.h"
+#include "Grid15/Corpus.h"
+#include "Grid15/BoardList.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <istream>
+#include <ostream>
+
+
+/** \namespace SlideSolve
+ *
+ * \brief The headless batch solver (15Slide-solve), which uses Grid15 without GTKSlide or CommandUI
+ *
+ * \author John Jekel
+ * \date 2018-2018
+*/
+namespace SlideSolve
+{
+    typedef Grid15::BoardList::Entry Board;///<A board read from the input, with the line it was on or why it could not be read
+
+    /** \brief The outcome of solving one board
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    struct Row
+    {
+        std::size_t line {0};               ///<The line of the input the board was on
+        Grid15::Solver::Result result {};   ///<The solution and node count
+        double seconds {0};                 ///<The wall time spent solving
+        std::string error {};               ///<Why the board could not be solved, or empty
+    };
+
+    std::vector<Board> readBoards(std::istream &input);
+    std::vector<Board> readBoards(const std::string &file);
+    std::vector<Board> readBoards(const Grid15::Corpus &corpus);
+    std::string formatRow(const Row &row);
+    std::string formatBoard(const Grid15::Grid &grid);
+
+    /** \class BatchSolver
+     *
+     * \brief Solves many boards at once on a pool of threads, writing one row per board in input order
+     *
+     * Each thread takes the next unsolved board until there are none left. Boards that are invalid or unsolvable get an error row
+     * instead of stopping the batch.
+     *
+     * \author John Jekel
+     * \date 2018-2018
+     */
+    class BatchSolver
+    {
+        public:
+            BatchSolver(const std::size_t newThreads = 0, const std::size_t newSearchThreads = 1);
+
+            void useWalkingDistance();
+            void usePatternDatabase(const std::string &file);
+
+            Row solve(const Board &board) const;
+            void solve(const std::vector<Board> &boards, std::ostream &output) const;
+
+            std::vector<Grid15::Generator::Puzzle> generate(const std::size_t count, const Grid15::Generator::Range range) const;
+            std::size_t generate(const std::size_t count, const Grid15::Generator::Range range, std::ostream &output) const;
+            std::size_t generate(const std::size_t count, const Grid15::Generator::Range range, Grid15::CorpusWriter &corpus) const;
+
+            static constexpr char HEADER[] {"#line\tlength\tnodes\tseconds\tmoves"};///<The first line of the output
+
+        private:
+            std::size_t threads {0};                                ///<The number of boards to solve at once
+            std::size_t searchThreads {1};                          ///<The number of threads each board's search uses (see Grid15::Solver::solve)
+            std::unique_ptr<Grid15::WalkingDistance> walking {};    ///<The walking distance tables, if used
+            std::unique_ptr<Grid15::PatternDatabase> database {};   ///<The pattern databases, if used
+    };
+}
+#endif //BATCHSOLVER_H
@@ -0,0 +1,310 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 John Jekel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "SlideSolve/BatchSolver.h"
+#include "Grid15/Generator.h"
+#include "Grid15/Corpus.h"
+#include "Grid15/PatternDatabase.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+
+
+namespace
+{
+    ///Prints how to use 15Slide-solve
+    void displayUsage()
+    {
+        std::cout << "Usage: 15Slide-solve [options] [file]" << "\n";
+        std::cout << "Solves boards optimally, one per line of the file (or stdin if there is no file or it is \"-\")." << "\n";
+        std::cout << "A board is 16 numbers from 0 to 15 (0 is the empty space) separated by spaces or commas, like a 15Slide save file." << "\n";
+        std::cout << "\n";
+        std::cout << "Options:" << "\n";
+        std::cout << "  -t, --threads num         Boards to solve at once (default: one per hardware thread)" << "\n";
+        std::cout << "  -s, --search-threads num  Threads each board's search uses (default: 1)" << "\n";
+        std::cout << "  -w, --walking             Use walking distance instead of Manhattan distance and linear conflict" << "\n";
+        std::cout << "  -p, --pdb file            Use a saved pattern database (see --build-pdb) instead of Manhattan distance and linear conflict" << "\n";
+        std::cout << "  -c, --corpus              The file is a binary corpus (see Grid15::Corpus) instead of text" << "\n";
+        std::cout << "  -g, --generate num        Make num random boards instead of solving any (see --difficulty)" << "\n";
+        std::cout << "  -d, --difficulty range    Optimal lengths of generated boards: easy, medium, hard or min-max (default: medium)" << "\n";
+        std::cout << "  -o, --output-corpus file  Write generated boards and their lengths to a binary corpus instead of stdout" << "\n";
+        std::cout << "  -b, --build-pdb file      Build a pattern database for --pdb and save it to file instead of solving any boards" << "\n";
+        std::cout << "  -P, --partition tiles     Tiles in each pattern of --build-pdb: 5-5-5, 6-6-3 or 7-8 (default: 7-8, the strongest," << "\n";
+        std::cout << "                            but it needs about 1.7 GB of memory and a long time to build)" << "\n";
+        std::cout << "  -e, --encoding how        How --build-pdb stores the tables: byte, nibble, mod-three or min-folded (default: byte)" << "\n";
+        std::cout << "  -h, --help                Show this" << "\n";
+        std::cout << "\n";
+        std::cout << "Output is one tab separated row per board: line, length, nodes expanded, seconds, moves (tiles to slide)." << "\n";
+        std::cout << "Generated boards are written one per line with their optimal length in a comment, so they can be solved again." << "\n";
+    }
+
+    /** \brief Reads a count from the command line
+     *
+     * \param argument The argument to read
+     * \return The count
+     * \throw std::invalid_argument If the argument is not a whole number
+     */
+    std::size_t readCount(const std::string &argument)
+    {
+        std::size_t end {0};
+        unsigned long count {0};
+
+        try
+        {
+            count = {std::stoul(argument, &end)};
+        }
+        catch (std::logic_error &e)//std::invalid_argument or std::out_of_range
+        {
+            end = {0};
+        }
+
+        if (argument.empty() || end != argument.size() || argument[0] == '-')
+            throw std::invalid_argument {"not a whole number: \"" + argument + "\""};
+
+        return static_cast<std::size_t> (count);
+    }
+
+    /** \brief Reads a difficulty from the command line
+     *
+     * \param argument The argument to read: easy, medium, hard or min-max
+     * \return The range of optimal lengths
+     * \throw std::invalid_argument If the argument is not a difficulty or range
+     */
+    Grid15::Generator::Range readDifficulty(const std::string &argument)
+    {
+        if (argument == "easy")
+            return Grid15::Generator::difficultyRange(Grid15::Generator::Difficulty::EASY);
+        else if (argument == "medium")
+            return Grid15::Generator::difficultyRange(Grid15::Generator::Difficulty::MEDIUM);
+        else if (argument == "hard")
+            return Grid15::Generator::difficultyRange(Grid15::Generator::Difficulty::HARD);
+
+        const std::size_t dash {argument.find('-')};
+
+        if (dash == std::string::npos)
+            throw std::invalid_argument {"not a difficulty: \"" + argument + "\""};
+
+        const std::size_t min {readCount(argument.substr(0, dash))};
+        const std::size_t max {readCount(argument.substr(dash + 1))};
+
+        if (min > max || max > 80)
+            throw std::invalid_argument {"not a range of lengths from 0 to 80: \"" + argument + "\""};
+
+        return {static_cast<std::uint8_t> (min), static_cast<std::uint8_t> (max)};
+    }
+
+    /** \brief Reads a pattern database partition from the command line
+     *
+     * \param argument The argument to read: 5-5-5, 6-6-3 or 7-8
+     * \return The partition
+     * \throw std::invalid_argument If the argument is not a partition
+     */
+    Grid15::PatternDatabase::Partition readPartition(const std::string &argument)
+    {
+        if (argument == "5-5-5")
+            return Grid15::PatternDatabase::Partition::FIVE_FIVE_FIVE;
+        else if (argument == "6-6-3")
+            return Grid15::PatternDatabase::Partition::SIX_SIX_THREE;
+        else if (argument == "7-8")
+            return Grid15::PatternDatabase::Partition::SEVEN_EIGHT;
+        else
+            throw std::invalid_argument {"not a partition: \"" + argument + "\""};
+    }
+
+    /** \brief Reads a pattern database encoding from the command line
+     *
+     * \param argument The argument to read: byte, nibble, mod-three or min-folded
+     * \return The encoding
+     * \throw std::invalid_argument If the argument is not an encoding
+     */
+    Grid15::PatternDatabase::Encoding readEncoding(const std::string &argument)
+    {
+        if (argument == "byte")
+            return Grid15::PatternDatabase::Encoding::BYTE;
+        else if (argument == "nibble")
+            return Grid15::PatternDatabase::Encoding::NIBBLE;
+        else if (argument == "mod-three")
+            return Grid15::PatternDatabase::Encoding::MOD_THREE;
+        else if (argument == "min-folded")
+            return Grid15::PatternDatabase::Encoding::MIN_FOLDED;
+        else
+            throw std::invalid_argument {"not an encoding: \"" + argument + "\""};
+    }
+
+    /** \brief Builds a pattern database and saves it, for --pdb
+     *
+     * \param file The file to save to
+     * \param partition The tiles in each pattern
+     * \param encoding How to store the tables
+     * \throw std::ios_base::failure If the file cannot be written
+     */
+    void buildDatabase(const std::string &file, const Grid15::PatternDatabase::Partition partition, const Grid15::PatternDatabase::Encoding encoding)
+    {
+        std::cerr << "15Slide-solve: building the pattern database..." << "\n";
+
+        const Grid15::PatternDatabase built {partition};
+
+        if (encoding == Grid15::PatternDatabase::Encoding::BYTE)
+            built.save(file);
+        else
+            Grid15::PatternDatabase {built, encoding}.save(file);
+
+        std::cerr << "15Slide-solve: saved the pattern database to " << file << "\n";
+    }
+}
+
+
+/** \brief 15Slide-solve main function
+ *
+ * \author John Jekel
+ * \date 2018-2018
+**/
+int main(int argc, char *argv[])
+{
+    try
+    {
+        std::size_t threads {0};
+        std::size_t searchThreads {1};
+        bool walking {false};
+        std::string databaseFile {};
+        std::string inputFile {"-"};
+        bool corpusInput {false};
+        std::string corpusOutput {};
+        std::size_t generateCount {0};
+        std::string buildFile {};
+        Grid15::PatternDatabase::Partition partition {Grid15::PatternDatabase::Partition::SEVEN_EIGHT};
+        Grid15::PatternDatabase::Encoding encoding {Grid15::PatternDatabase::Encoding::BYTE};
+        Grid15::Generator::Range range {Grid15::Generator::difficultyRange(Grid15::Generator::Difficulty::MEDIUM)};
+
+        const std::vector<std::string> arguments(argv + 1, argv + argc);
+
+        for (std::size_t i {0}; i < arguments.size(); ++i)
+        {
+            const std::string &argument {arguments[i]};
+            const bool hasValue {i + 1 < arguments.size()};
+
+            if (argument == "-h" || argument == "--help")
+            {
+                displayUsage();
+                return 0;
+            }
+            else if ((argument == "-t" || argument == "--threads") && hasValue)
+                threads = {readCount(arguments[++i])};
+            else if ((argument == "-s" || argument == "--search-threads") && hasValue)
+                searchThreads = {readCount(arguments[++i])};
+            else if (argument == "-w" || argument == "--walking")
+                walking = {true};
+            else if ((argument == "-p" || argument == "--pdb") && hasValue)
+                databaseFile = {arguments[++i]};
+            else if (argument == "-c" || argument == "--corpus")
+                corpusInput = {true};
+            else if ((argument == "-o" || argument == "--output-corpus") && hasValue)
+                corpusOutput = {arguments[++i]};
+            else if ((argument == "-g" || argument == "--generate") && hasValue)
+                generateCount = {readCount(arguments[++i])};
+            else if ((argument == "-d" || argument == "--difficulty") && hasValue)
+                range = {readDifficulty(arguments[++i])};
+            else if ((argument == "-b" || argument == "--build-pdb") && hasValue)
+                buildFile = {arguments[++i]};
+            else if ((argument == "-P" || argument == "--partition") && hasValue)
+                partition = {readPartition(arguments[++i])};
+            else if ((argument == "-e" || argument == "--encoding") && hasValue)
+                encoding = {readEncoding(arguments[++i])};
+            else if (argument == "-" || argument[0] != '-')
+                inputFile = {argument};
+            else
+            {
+                std::cerr << "15Slide-solve: bad argument \"" << argument << "\"; try --help" << "\n";
+                return 2;
+            }
+        }
+
+        if (!buildFile.empty())
+        {
+            buildDatabase(buildFile, partition, encoding);
+            return 0;
+        }
+
+        SlideSolve::BatchSolver solver {threads, searchThreads};
+
+        if (!databaseFile.empty())
+            solver.usePatternDatabase(databaseFile);
+        else if (walking)
+            solver.useWalkingDistance();
+
+        if (generateCount != 0)
+        {
+            std::size_t made {0};
+
+            if (corpusOutput.empty())
+                made = {solver.generate(generateCount, range, std::cout)};
+            else
+            {
+                Grid15::CorpusWriter corpus {corpusOutput, true};
+                made = {solver.generate(generateCount, range, corpus)};
+                corpus.close();
+            }
+
+            if (made < generateCount)
+            {
+                std::cerr << "15Slide-solve: only made " << made << " of " << generateCount << " boards; the difficulty range is too hard to hit" << "\n";
+                return 1;
+            }
+
+            return 0;
+        }
+
+        std::vector<SlideSolve::Board> boards {};
+
+        if (corpusInput)
+        {
+            const Grid15::Corpus corpus {inputFile};
+
+            if (!corpus.verify())
+            {
+                std::cerr << "15Slide-solve: \"" << inputFile << "\" does not match its checksum" << "\n";
+                return 1;
+            }
+
+            boards = {SlideSolve::readBoards(corpus)};
+        }
+        else if (inputFile == "-")
+            boards = {SlideSolve::readBoards(std::cin)};
+        else
+            boards = {SlideSolve::readBoards(inputFile)};
+
+        solver.solve(boards, std::cout);
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "15Slide-solve: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
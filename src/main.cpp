@@ -74,26 +74,38 @@ int main(int argc, char *argv[])
 
         std::shared_ptr<Grid15::Grid> gameGrid {new Grid15::Grid {}};
 
+        #if defined(ENABLE_GUI)
+        constexpr bool machineMode {false};
+        #else
+        const bool machineMode {CommandUI::wantsMachineMode(argc, argv)};//for scripts; nothing but responses is written
+        #endif
+
         if constexpr (ProgramStuff::CHEAT_MODE)
         {
             Grid15::GridHelp::safeCopy(Grid15::Grid::GOAL_GRID, *gameGrid);//start initiliazed as the goal grid
             Grid15::GridHelp::swapTile(15, *gameGrid);//instead of setting an entire new grid
 
-            std::cout << termcolor::on_red;
-            std::cout << "CHEATING BUILD" << "\n";
-            std::cout << termcolor::reset;
+            if (!machineMode)
+            {
+                std::cout << termcolor::on_red;
+                std::cout << "CHEATING BUILD" << "\n";
+                std::cout << termcolor::reset;
+            }
         }
         else
             Grid15::GridHelp::safeCopy(Grid15::GridHelp::generateRandomGrid(), *gameGrid);
 
 
-        if constexpr (ProgramStuff::CLEAR_SCREEN_ON_START)
-            std::cout << "\x1b[2J";//dosent work well, maybe not at all on Windows
+        if (!machineMode)
+        {
+            if constexpr (ProgramStuff::CLEAR_SCREEN_ON_START)
+                std::cout << "\x1b[2J";//dosent work well, maybe not at all on Windows
 
-        std::cout << termcolor::reverse << termcolor::bold;
-        std::cout << "15Slide" << "\n";
-        std::cout << termcolor::reset;
-        std::cout << std::endl;
+            std::cout << termcolor::reverse << termcolor::bold;
+            std::cout << "15Slide" << "\n";
+            std::cout << termcolor::reset;
+            std::cout << std::endl;
+        }
 
 
         #if defined(ENABLE_GUI)
@@ -116,6 +128,12 @@ int main(int argc, char *argv[])
 
         return application->run(window);//run GTKSlide and then end the main function returning the code from GTK
         #else
+        if (machineMode)
+        {
+            CommandUI machineUI {};
+            machineUI.startMachine(*gameGrid);
+            return 0;
+        }
 
 
         std::cout << "Type \"help\" for a list of commands." << "\n";